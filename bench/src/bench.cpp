@@ -0,0 +1,191 @@
+#include "bench.h"
+#include "iol_array.h"
+#include "iol_file.h"
+#include "iol_sort.h"
+#include "iol_string.h"
+#include "iol_debug.h"
+
+#include <chrono>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <time.h>
+
+namespace iol
+{
+	static Array<bench::Benchmark> s_benchmarks;
+	static volatile uint64 s_sink;
+
+	static double bench_get_percentile(const Array<double>& sortedTimes, double percentile)
+	{
+		// Nearest rank
+		size_t rank = (size_t)ceil(percentile * sortedTimes.count);
+		return sortedTimes[rank > 0 ? rank - 1 : 0];
+	}
+
+	static double bench_time_run(const bench::Benchmark& benchmark)
+	{
+		if (benchmark.setup != nullptr)
+			benchmark.setup(benchmark.pUserData);
+
+		auto start = std::chrono::steady_clock::now();
+		benchmark.run(benchmark.pUserData);
+		auto end = std::chrono::steady_clock::now();
+
+		if (benchmark.teardown != nullptr)
+			benchmark.teardown(benchmark.pUserData);
+
+		return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	}
+
+	static bench::Result bench_run(const bench::Benchmark& benchmark, const bench::Settings& settings)
+	{
+		for (uint32 i = 0; i < settings.warmups; i++)
+			bench_time_run(benchmark);
+
+		Array<double> times(settings.repetitions);
+		double sum = 0.0;
+
+		for (uint32 i = 0; i < settings.repetitions; i++)
+		{
+			double time = bench_time_run(benchmark) / (double)benchmark.numOperations;
+			times.PushBack(time);
+			sum += time;
+		}
+
+		sort::Sort(times);
+
+		bench::Result result;
+		result.pName = benchmark.pName;
+		result.numOperations = benchmark.numOperations;
+		result.repetitions = settings.repetitions;
+		result.minNs = times[0];
+		result.meanNs = sum / settings.repetitions;
+		result.p50Ns = bench_get_percentile(times, 0.50);
+		result.p90Ns = bench_get_percentile(times, 0.90);
+		result.p99Ns = bench_get_percentile(times, 0.99);
+		result.maxNs = times[times.count - 1];
+
+		return result;
+	}
+
+	static void bench_write_line(File* pFile, const char* pFormat, ...)
+	{
+		char line[512];
+
+		va_list args;
+		va_start(args, pFormat);
+		int length = vsnprintf(line, sizeof(line), pFormat, args);
+		va_end(args);
+
+		iol_assert(length >= 0 && (size_t)length < sizeof(line));
+		file::Write(pFile, line, (size_t)length);
+	}
+
+	static bool bench_write_json(const char* pFilePath, const Array<bench::Result>& results, const bench::Settings& settings)
+	{
+		File* pFile = file::Open(pFilePath, FileMode::BinaryWrite);
+
+		if (pFile == nullptr)
+		{
+			iol_log_error("Failed to open benchmark output file: '%s'", pFilePath);
+			return false;
+		}
+
+#if defined(IOL_DEBUG)
+		const char* pConfig = "debug";
+#elif defined(IOL_RELEASE)
+		const char* pConfig = "release";
+#else
+		const char* pConfig = "master";
+#endif
+
+#if defined(_MSC_VER)
+		char compiler[32];
+		snprintf(compiler, sizeof(compiler), "msvc %d", _MSC_VER);
+#elif defined(__VERSION__)
+		const char* compiler = __VERSION__;
+#else
+		const char* compiler = "unknown";
+#endif
+
+		bench_write_line(pFile, "{\n");
+		bench_write_line(pFile, "\t\"timestamp\": %lld,\n", (long long)time(nullptr));
+		bench_write_line(pFile, "\t\"config\": \"%s\",\n", pConfig);
+		bench_write_line(pFile, "\t\"compiler\": \"%s\",\n", compiler);
+		bench_write_line(pFile, "\t\"warmups\": %u,\n", settings.warmups);
+		bench_write_line(pFile, "\t\"unit\": \"ns_per_operation\",\n");
+		bench_write_line(pFile, "\t\"benchmarks\": [\n");
+
+		for (size_t i = 0; i < results.count; i++)
+		{
+			const bench::Result& result = results[i];
+
+			bench_write_line(pFile, "\t\t{ \"name\": \"%s\", \"operations\": %zu, \"repetitions\": %u, ", result.pName, result.numOperations, result.repetitions);
+			bench_write_line(pFile, "\"min\": %.3f, \"mean\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f }%s\n",
+				result.minNs, result.meanNs, result.p50Ns, result.p90Ns, result.p99Ns, result.maxNs, i + 1 < results.count ? "," : "");
+		}
+
+		bench_write_line(pFile, "\t]\n");
+		bench_write_line(pFile, "}\n");
+		file::Close(pFile);
+
+		return true;
+	}
+
+	void bench::Add(const char* pName, size_t numOperations, void* pUserData, void(*run)(void* pUserData), void(*setup)(void* pUserData), void(*teardown)(void* pUserData))
+	{
+		iol_assert(numOperations > 0);
+
+		if (s_benchmarks.pData == nullptr)
+			s_benchmarks.CreateGrowable(64);
+
+		Benchmark& benchmark = s_benchmarks.PushBack();
+		benchmark.pName = pName;
+		benchmark.numOperations = numOperations;
+		benchmark.pUserData = pUserData;
+		benchmark.run = run;
+		benchmark.setup = setup;
+		benchmark.teardown = teardown;
+	}
+
+	bool bench::RunAll(const Settings& settings)
+	{
+		iol_assert(settings.repetitions > 0);
+
+		Array<Result> results(s_benchmarks.count > 0 ? s_benchmarks.count : 1);
+
+		printf("%-48s %12s %12s %12s %12s\n", "benchmark (ns/op)", "min", "p50", "p90", "p99");
+
+		for (size_t i = 0; i < s_benchmarks.count; i++)
+		{
+			const Benchmark& benchmark = s_benchmarks[i];
+
+			if (settings.pFilter != nullptr && !string::Contains(benchmark.pName, settings.pFilter))
+				continue;
+
+			Result& result = results.PushBack(bench_run(benchmark, settings));
+			printf("%-48s %12.3f %12.3f %12.3f %12.3f\n", result.pName, result.minNs, result.p50Ns, result.p90Ns, result.p99Ns);
+		}
+
+		return bench_write_json(settings.pOutputPath, results, settings);
+	}
+
+	void bench::Shutdown()
+	{
+		s_benchmarks.Destroy();
+	}
+
+	void bench::Consume(uint64 value)
+	{
+		s_sink = value;
+	}
+
+	uint64 bench::Random(uint64 index)
+	{
+		uint64 z = index + 0x9E3779B97F4A7C15ull;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef IOLITE_BENCH_H
+#define IOLITE_BENCH_H
+
+#include "iol_definitions.h"
+
+namespace iol
+{
+	namespace bench
+	{
+		/*
+		* A benchmark runs 'numOperations' operations per call of 'run'. 'setup' and 'teardown' are optional
+		* and run untimed before and after every call, so every repetition starts from the same state.
+		*/
+		struct Benchmark
+		{
+			const char* pName;
+			size_t numOperations;
+			void* pUserData;
+			void (*run)(void* pUserData);
+			void (*setup)(void* pUserData);
+			void (*teardown)(void* pUserData);
+		};
+
+		// Nanoseconds per operation over all repetitions
+		struct Result
+		{
+			const char* pName;
+			size_t numOperations;
+			uint32 repetitions;
+			double minNs;
+			double meanNs;
+			double p50Ns;
+			double p90Ns;
+			double p99Ns;
+			double maxNs;
+		};
+
+		struct Settings
+		{
+			uint32 warmups = 3;
+			uint32 repetitions = 25;
+			const char* pFilter = nullptr; // only benchmarks whose name contains the filter are run
+			const char* pOutputPath = "bench_results.json";
+		};
+
+		void     Add(const char* pName, size_t numOperations, void* pUserData, void(*run)(void* pUserData), void(*setup)(void* pUserData) = nullptr, void(*teardown)(void* pUserData) = nullptr);
+		bool     RunAll(const Settings& settings);
+		void     Shutdown();
+
+		// Keeps a computed value alive so the compiler can't drop the work that produced it
+		void     Consume(uint64 value);
+		uint64   Random(uint64 index); // splitmix64 of index, cheap and reproducible test data
+
+		void     RegisterContainerBenchmarks();
+		void     RegisterStringBenchmarks();
+		void     RegisterMemoryBenchmarks();
+		void     DestroyContainerBenchmarks();
+		void     DestroyStringBenchmarks();
+		void     DestroyMemoryBenchmarks();
+	}
+}
+
+#endif // IOLITE_BENCH_H
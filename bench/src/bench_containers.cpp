@@ -0,0 +1,360 @@
+#include "bench.h"
+#include "iol_array.h"
+#include "iol_hashmap.h"
+#include "iol_flat_hashmap.h"
+
+#include <stdio.h>
+#include <unordered_map>
+#include <vector>
+
+namespace iol
+{
+	//-------------------------------------
+	// Array / std::vector
+	//-------------------------------------
+
+	struct ArrayBench
+	{
+		size_t count;
+		char names[4][64];
+		Array<uint32> array;
+		std::vector<uint32> vector;
+		Array<uint32> removeIndices; // index to remove at every step, precomputed so the loop only measures the container
+	};
+
+	static void array_bench_create_remove_indices(ArrayBench* pBench)
+	{
+		pBench->removeIndices.Create(pBench->count);
+
+		for (size_t remaining = pBench->count; remaining > 0; remaining--)
+			pBench->removeIndices.PushBack((uint32)(bench::Random(remaining) % remaining));
+	}
+
+	static void array_bench_fill(void* pUserData)
+	{
+		ArrayBench* pBench = (ArrayBench*)pUserData;
+		pBench->array.Create(pBench->count);
+		pBench->vector.reserve(pBench->count);
+
+		for (size_t i = 0; i < pBench->count; i++)
+		{
+			pBench->array.PushBack((uint32)i);
+			pBench->vector.push_back((uint32)i);
+		}
+	}
+
+	static void array_bench_release(void* pUserData)
+	{
+		ArrayBench* pBench = (ArrayBench*)pUserData;
+		pBench->array.Destroy();
+		pBench->vector.clear();
+		pBench->vector.shrink_to_fit();
+	}
+
+	static void array_bench_push_back(void* pUserData)
+	{
+		ArrayBench* pBench = (ArrayBench*)pUserData;
+		pBench->array.CreateGrowable(ARRAY_MIN_GROW_CAPACITY);
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->array.PushBack((uint32)i);
+
+		bench::Consume(pBench->array.count);
+	}
+
+	static void vector_bench_push_back(void* pUserData)
+	{
+		ArrayBench* pBench = (ArrayBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->vector.push_back((uint32)i);
+
+		bench::Consume(pBench->vector.size());
+	}
+
+	static void array_bench_remove_unordered(void* pUserData)
+	{
+		ArrayBench* pBench = (ArrayBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->array.RemoveAtUnordered(pBench->removeIndices[i]);
+
+		bench::Consume(pBench->array.count);
+	}
+
+	static void vector_bench_remove_unordered(void* pUserData)
+	{
+		ArrayBench* pBench = (ArrayBench*)pUserData;
+		std::vector<uint32>& vector = pBench->vector;
+
+		for (size_t i = 0; i < pBench->count; i++)
+		{
+			vector[pBench->removeIndices[i]] = vector.back();
+			vector.pop_back();
+		}
+
+		bench::Consume(vector.size());
+	}
+
+	static void array_bench_remove(void* pUserData)
+	{
+		ArrayBench* pBench = (ArrayBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->array.RemoveAt(pBench->removeIndices[i]);
+
+		bench::Consume(pBench->array.count);
+	}
+
+	static void vector_bench_remove(void* pUserData)
+	{
+		ArrayBench* pBench = (ArrayBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->vector.erase(pBench->vector.begin() + pBench->removeIndices[i]);
+
+		bench::Consume(pBench->vector.size());
+	}
+
+	//-------------------------------------
+	// Hashmap / FlatHashmap / std::unordered_map
+	//-------------------------------------
+
+	struct HashmapBench
+	{
+		size_t count;
+		uint32 hitPercent; // share of the lookups that find their key
+		char names[3][3][64]; // get, add and remove name per container
+		Array<uint64> keys;
+		Array<uint64> lookupKeys;
+		Hashmap<uint64, uint64> hashmap;
+		FlatHashmap<uint64, uint64> flatHashmap;
+		std::unordered_map<uint64, uint64> unorderedMap;
+	};
+
+	static void hashmap_bench_create_keys(HashmapBench* pBench)
+	{
+		pBench->keys.Create(pBench->count);
+		pBench->lookupKeys.Create(pBench->count);
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->keys.PushBack(bench::Random(i));
+
+		// Misses use keys past the inserted range
+		for (size_t i = 0; i < pBench->count; i++)
+		{
+			bool hit = bench::Random(~i) % 100 < pBench->hitPercent;
+			pBench->lookupKeys.PushBack(hit ? pBench->keys[bench::Random(i + pBench->count) % pBench->count] : bench::Random(i + pBench->count));
+		}
+	}
+
+	static void hashmap_bench_clear(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+		pBench->hashmap.Destroy();
+		pBench->flatHashmap.Destroy();
+		pBench->unorderedMap = std::unordered_map<uint64, uint64>();
+	}
+
+	static void hashmap_bench_create(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+		pBench->hashmap.Create(pBench->count);
+		pBench->flatHashmap.Create(pBench->count);
+		pBench->unorderedMap.reserve(pBench->count);
+	}
+
+	static void hashmap_bench_fill(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+		hashmap_bench_create(pUserData);
+
+		for (size_t i = 0; i < pBench->count; i++)
+		{
+			uint64 key = pBench->keys[i];
+			pBench->hashmap.Add(key, i);
+			pBench->flatHashmap.Add(key, i);
+			pBench->unorderedMap.emplace(key, i);
+		}
+	}
+
+	static void hashmap_bench_add(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->hashmap.Add(pBench->keys[i], i);
+
+		bench::Consume(pBench->hashmap.GetCount());
+	}
+
+	static void flat_hashmap_bench_add(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->flatHashmap.Add(pBench->keys[i], i);
+
+		bench::Consume(pBench->flatHashmap.GetCount());
+	}
+
+	static void unordered_map_bench_add(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->unorderedMap.emplace(pBench->keys[i], i);
+
+		bench::Consume(pBench->unorderedMap.size());
+	}
+
+	static void hashmap_bench_get(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < pBench->count; i++)
+		{
+			const uint64* pValue = pBench->hashmap.Get(pBench->lookupKeys[i]);
+			sum += pValue != nullptr ? *pValue : 1;
+		}
+
+		bench::Consume(sum);
+	}
+
+	static void flat_hashmap_bench_get(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < pBench->count; i++)
+		{
+			const uint64* pValue = pBench->flatHashmap.Get(pBench->lookupKeys[i]);
+			sum += pValue != nullptr ? *pValue : 1;
+		}
+
+		bench::Consume(sum);
+	}
+
+	static void unordered_map_bench_get(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < pBench->count; i++)
+		{
+			auto it = pBench->unorderedMap.find(pBench->lookupKeys[i]);
+			sum += it != pBench->unorderedMap.end() ? it->second : 1;
+		}
+
+		bench::Consume(sum);
+	}
+
+	static void hashmap_bench_remove(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->hashmap.Remove(pBench->keys[i]);
+
+		bench::Consume(pBench->hashmap.GetCount());
+	}
+
+	static void flat_hashmap_bench_remove(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->flatHashmap.Remove(pBench->keys[i]);
+
+		bench::Consume(pBench->flatHashmap.GetCount());
+	}
+
+	static void unordered_map_bench_remove(void* pUserData)
+	{
+		HashmapBench* pBench = (HashmapBench*)pUserData;
+
+		for (size_t i = 0; i < pBench->count; i++)
+			pBench->unorderedMap.erase(pBench->keys[i]);
+
+		bench::Consume(pBench->unorderedMap.size());
+	}
+
+	//-------------------------------------
+
+	static ArrayBench s_arrayBenches[] = { { 1000 }, { 100000 } };
+	static ArrayBench s_arrayRemoveBench = { 4000 }; // ordered removal is quadratic, one small size is enough
+	static HashmapBench s_hashmapBenches[] = { { 1000, 100 }, { 1000, 50 }, { 100000, 100 }, { 100000, 50 }, { 100000, 0 } };
+
+	void bench::RegisterContainerBenchmarks()
+	{
+		for (ArrayBench& arrayBench : s_arrayBenches)
+		{
+			array_bench_create_remove_indices(&arrayBench);
+
+			size_t count = arrayBench.count;
+			snprintf(arrayBench.names[0], sizeof(arrayBench.names[0]), "array/push_back/%zu", count);
+			snprintf(arrayBench.names[1], sizeof(arrayBench.names[1]), "std_vector/push_back/%zu", count);
+			snprintf(arrayBench.names[2], sizeof(arrayBench.names[2]), "array/remove_unordered/%zu", count);
+			snprintf(arrayBench.names[3], sizeof(arrayBench.names[3]), "std_vector/remove_unordered/%zu", count);
+
+			bench::Add(arrayBench.names[0], count, &arrayBench, array_bench_push_back, nullptr, array_bench_release);
+			bench::Add(arrayBench.names[1], count, &arrayBench, vector_bench_push_back, nullptr, array_bench_release);
+			bench::Add(arrayBench.names[2], count, &arrayBench, array_bench_remove_unordered, array_bench_fill, array_bench_release);
+			bench::Add(arrayBench.names[3], count, &arrayBench, vector_bench_remove_unordered, array_bench_fill, array_bench_release);
+		}
+
+		array_bench_create_remove_indices(&s_arrayRemoveBench);
+		bench::Add("array/remove/4000", s_arrayRemoveBench.count, &s_arrayRemoveBench, array_bench_remove, array_bench_fill, array_bench_release);
+		bench::Add("std_vector/remove/4000", s_arrayRemoveBench.count, &s_arrayRemoveBench, vector_bench_remove, array_bench_fill, array_bench_release);
+
+		for (HashmapBench& hashmapBench : s_hashmapBenches)
+		{
+			hashmap_bench_create_keys(&hashmapBench);
+
+			size_t count = hashmapBench.count;
+			const char* containerNames[] = { "hashmap", "flat_hashmap", "std_unordered_map" };
+			void(*addFunctions[])(void*) = { hashmap_bench_add, flat_hashmap_bench_add, unordered_map_bench_add };
+			void(*getFunctions[])(void*) = { hashmap_bench_get, flat_hashmap_bench_get, unordered_map_bench_get };
+			void(*removeFunctions[])(void*) = { hashmap_bench_remove, flat_hashmap_bench_remove, unordered_map_bench_remove };
+
+			for (size_t i = 0; i < iol_countof(containerNames); i++)
+			{
+				char* pName = hashmapBench.names[i][0];
+				snprintf(pName, sizeof(hashmapBench.names[i][0]), "%s/get/%zu/hit%u", containerNames[i], count, hashmapBench.hitPercent);
+				bench::Add(pName, count, &hashmapBench, getFunctions[i], hashmap_bench_fill, hashmap_bench_clear);
+
+				// Adding and removing don't depend on the hit rate, measure them once per size
+				if (hashmapBench.hitPercent != 100)
+					continue;
+
+				pName = hashmapBench.names[i][1];
+				snprintf(pName, sizeof(hashmapBench.names[i][1]), "%s/add/%zu", containerNames[i], count);
+				bench::Add(pName, count, &hashmapBench, addFunctions[i], hashmap_bench_create, hashmap_bench_clear);
+
+				pName = hashmapBench.names[i][2];
+				snprintf(pName, sizeof(hashmapBench.names[i][2]), "%s/remove/%zu", containerNames[i], count);
+				bench::Add(pName, count, &hashmapBench, removeFunctions[i], hashmap_bench_fill, hashmap_bench_clear);
+			}
+		}
+	}
+
+	void bench::DestroyContainerBenchmarks()
+	{
+		for (ArrayBench& arrayBench : s_arrayBenches)
+		{
+			array_bench_release(&arrayBench);
+			arrayBench.removeIndices.Destroy();
+		}
+
+		array_bench_release(&s_arrayRemoveBench);
+		s_arrayRemoveBench.removeIndices.Destroy();
+
+		for (HashmapBench& hashmapBench : s_hashmapBenches)
+		{
+			hashmap_bench_clear(&hashmapBench);
+			hashmapBench.keys.Destroy();
+			hashmapBench.lookupKeys.Destroy();
+		}
+	}
+}
@@ -0,0 +1,225 @@
+#include "bench.h"
+#include "iol_memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MEMORY_BYTES_PER_RUN   (4 * 1024 * 1024)
+#define BENCH_MEMORY_MAX_BLOCK_SIZE  (1024 * 1024)
+#define BENCH_MEMORY_NUM_ALLOCATIONS 10000
+#define BENCH_MEMORY_ALLOCATION_SIZE 64
+
+namespace iol
+{
+	// Every run touches BENCH_MEMORY_BYTES_PER_RUN bytes, split into blocks of 'blockSize'
+	struct MemoryBench
+	{
+		size_t blockSize;
+		char names[6][64];
+	};
+
+	struct AllocationBench
+	{
+		void* pointers[BENCH_MEMORY_NUM_ALLOCATIONS];
+		LinearAllocator linearAllocator;
+		PoolAllocator poolAllocator;
+	};
+
+	static uint8* s_pSource;
+	static uint8* s_pDestination;
+	static MemoryBench s_memoryBenches[] = { { 64 }, { 4096 }, { BENCH_MEMORY_MAX_BLOCK_SIZE } };
+	static AllocationBench s_allocationBench;
+
+	iol_inline size_t memory_bench_get_num_blocks(const MemoryBench* pBench)
+	{
+		return BENCH_MEMORY_BYTES_PER_RUN / pBench->blockSize;
+	}
+
+	// Blocks cycle through a 1MB window, so the small sizes mostly run from cache and the large ones from memory
+	iol_inline size_t memory_bench_get_offset(const MemoryBench* pBench, size_t block)
+	{
+		return (block * pBench->blockSize) % BENCH_MEMORY_MAX_BLOCK_SIZE;
+	}
+
+	static void memory_bench_copy(void* pUserData)
+	{
+		MemoryBench* pBench = (MemoryBench*)pUserData;
+		size_t numBlocks = memory_bench_get_num_blocks(pBench);
+
+		for (size_t i = 0; i < numBlocks; i++)
+		{
+			size_t offset = memory_bench_get_offset(pBench, i);
+			memory::Copy(s_pDestination + offset, pBench->blockSize, s_pSource + offset);
+		}
+
+		bench::Consume(s_pDestination[0]);
+	}
+
+	static void memcpy_bench(void* pUserData)
+	{
+		MemoryBench* pBench = (MemoryBench*)pUserData;
+		size_t numBlocks = memory_bench_get_num_blocks(pBench);
+
+		for (size_t i = 0; i < numBlocks; i++)
+		{
+			size_t offset = memory_bench_get_offset(pBench, i);
+			memcpy(s_pDestination + offset, s_pSource + offset, pBench->blockSize);
+		}
+
+		bench::Consume(s_pDestination[0]);
+	}
+
+	static void memory_bench_fill_zero(void* pUserData)
+	{
+		MemoryBench* pBench = (MemoryBench*)pUserData;
+		size_t numBlocks = memory_bench_get_num_blocks(pBench);
+
+		for (size_t i = 0; i < numBlocks; i++)
+			memory::FillZero(s_pDestination + memory_bench_get_offset(pBench, i), pBench->blockSize);
+
+		bench::Consume(s_pDestination[0]);
+	}
+
+	static void memset_bench(void* pUserData)
+	{
+		MemoryBench* pBench = (MemoryBench*)pUserData;
+		size_t numBlocks = memory_bench_get_num_blocks(pBench);
+
+		for (size_t i = 0; i < numBlocks; i++)
+			memset(s_pDestination + memory_bench_get_offset(pBench, i), 0, pBench->blockSize);
+
+		bench::Consume(s_pDestination[0]);
+	}
+
+	// The destination holds a copy of the source, every comparison runs over the full block
+	static void memory_bench_prepare_compare(void* pUserData)
+	{
+		iol_use(pUserData);
+		memcpy(s_pDestination, s_pSource, BENCH_MEMORY_MAX_BLOCK_SIZE);
+	}
+
+	static void memory_bench_compare(void* pUserData)
+	{
+		MemoryBench* pBench = (MemoryBench*)pUserData;
+		size_t numBlocks = memory_bench_get_num_blocks(pBench);
+		uint64 numEqual = 0;
+
+		for (size_t i = 0; i < numBlocks; i++)
+		{
+			size_t offset = memory_bench_get_offset(pBench, i);
+			numEqual += memory::Compare(s_pDestination + offset, s_pSource + offset, pBench->blockSize) ? 1 : 0;
+		}
+
+		bench::Consume(numEqual);
+	}
+
+	static void memcmp_bench(void* pUserData)
+	{
+		MemoryBench* pBench = (MemoryBench*)pUserData;
+		size_t numBlocks = memory_bench_get_num_blocks(pBench);
+		uint64 numEqual = 0;
+
+		for (size_t i = 0; i < numBlocks; i++)
+		{
+			size_t offset = memory_bench_get_offset(pBench, i);
+			numEqual += memcmp(s_pDestination + offset, s_pSource + offset, pBench->blockSize) == 0 ? 1 : 0;
+		}
+
+		bench::Consume(numEqual);
+	}
+
+	//-------------------------------------
+	// Allocation: every operation is one allocation and its matching free
+	//-------------------------------------
+
+	static void iol_alloc_bench(void* pUserData)
+	{
+		AllocationBench* pBench = (AllocationBench*)pUserData;
+
+		for (size_t i = 0; i < BENCH_MEMORY_NUM_ALLOCATIONS; i++)
+			pBench->pointers[i] = iol_alloc_raw(BENCH_MEMORY_ALLOCATION_SIZE);
+
+		for (size_t i = 0; i < BENCH_MEMORY_NUM_ALLOCATIONS; i++)
+			iol_free(pBench->pointers[i]);
+	}
+
+	static void malloc_bench(void* pUserData)
+	{
+		AllocationBench* pBench = (AllocationBench*)pUserData;
+
+		for (size_t i = 0; i < BENCH_MEMORY_NUM_ALLOCATIONS; i++)
+			pBench->pointers[i] = malloc(BENCH_MEMORY_ALLOCATION_SIZE);
+
+		for (size_t i = 0; i < BENCH_MEMORY_NUM_ALLOCATIONS; i++)
+			free(pBench->pointers[i]);
+	}
+
+	static void linear_allocator_bench(void* pUserData)
+	{
+		AllocationBench* pBench = (AllocationBench*)pUserData;
+
+		for (size_t i = 0; i < BENCH_MEMORY_NUM_ALLOCATIONS; i++)
+			pBench->pointers[i] = pBench->linearAllocator.Allocate(BENCH_MEMORY_ALLOCATION_SIZE);
+
+		pBench->linearAllocator.Reset();
+	}
+
+	static void pool_allocator_bench(void* pUserData)
+	{
+		AllocationBench* pBench = (AllocationBench*)pUserData;
+
+		for (size_t i = 0; i < BENCH_MEMORY_NUM_ALLOCATIONS; i++)
+			pBench->pointers[i] = pBench->poolAllocator.Allocate();
+
+		for (size_t i = 0; i < BENCH_MEMORY_NUM_ALLOCATIONS; i++)
+			pBench->poolAllocator.Free(pBench->pointers[i]);
+	}
+
+	void bench::RegisterMemoryBenchmarks()
+	{
+		s_pSource = (uint8*)iol_alloc_raw_aligned(BENCH_MEMORY_MAX_BLOCK_SIZE, MEMORY_CACHE_LINE_SIZE);
+		s_pDestination = (uint8*)iol_alloc_raw_aligned(BENCH_MEMORY_MAX_BLOCK_SIZE, MEMORY_CACHE_LINE_SIZE);
+
+		for (size_t i = 0; i < BENCH_MEMORY_MAX_BLOCK_SIZE; i++)
+			s_pSource[i] = (uint8)bench::Random(i);
+
+		memory::FillZero(s_pDestination, BENCH_MEMORY_MAX_BLOCK_SIZE);
+
+		const char* functionNames[] = { "memory/copy", "libc/memcpy", "memory/fill_zero", "libc/memset", "memory/compare", "libc/memcmp" };
+		void(*functions[])(void*) = { memory_bench_copy, memcpy_bench, memory_bench_fill_zero, memset_bench, memory_bench_compare, memcmp_bench };
+		void(*setupFunctions[])(void*) = { nullptr, nullptr, nullptr, nullptr, memory_bench_prepare_compare, memory_bench_prepare_compare };
+
+		for (MemoryBench& memoryBench : s_memoryBenches)
+		{
+			for (size_t i = 0; i < iol_countof(functionNames); i++)
+			{
+				snprintf(memoryBench.names[i], sizeof(memoryBench.names[i]), "%s/%zu", functionNames[i], memoryBench.blockSize);
+				bench::Add(memoryBench.names[i], memory_bench_get_num_blocks(&memoryBench), &memoryBench, functions[i], setupFunctions[i]);
+			}
+		}
+
+		AllocationBench* pAllocationBench = &s_allocationBench;
+		pAllocationBench->linearAllocator.Create(BENCH_MEMORY_NUM_ALLOCATIONS * BENCH_MEMORY_ALLOCATION_SIZE);
+		pAllocationBench->poolAllocator.Create(BENCH_MEMORY_ALLOCATION_SIZE, BENCH_MEMORY_NUM_ALLOCATIONS);
+
+		bench::Add("memory/iol_alloc/64", BENCH_MEMORY_NUM_ALLOCATIONS, pAllocationBench, iol_alloc_bench);
+		bench::Add("libc/malloc/64", BENCH_MEMORY_NUM_ALLOCATIONS, pAllocationBench, malloc_bench);
+		bench::Add("memory/linear_allocator/64", BENCH_MEMORY_NUM_ALLOCATIONS, pAllocationBench, linear_allocator_bench);
+		bench::Add("memory/pool_allocator/64", BENCH_MEMORY_NUM_ALLOCATIONS, pAllocationBench, pool_allocator_bench);
+	}
+
+	void bench::DestroyMemoryBenchmarks()
+	{
+		s_allocationBench.linearAllocator.Destroy();
+		s_allocationBench.poolAllocator.Destroy();
+
+		if (s_pSource != nullptr)
+		{
+			iol_free_aligned(s_pSource);
+			iol_free_aligned(s_pDestination);
+			s_pSource = nullptr;
+			s_pDestination = nullptr;
+		}
+	}
+}
@@ -0,0 +1,303 @@
+#include "bench.h"
+#include "iol_string.h"
+#include "iol_memory.h"
+
+#include <string.h>
+
+#define BENCH_STRING_TEXT_SIZE  (64 * 1024)
+#define BENCH_STRING_SPACE_SIZE 4096
+#define BENCH_STRING_CALLS      16
+
+namespace iol
+{
+	/*
+	* Lowercase words split into lines of about 60 characters.
+	* The searched character and substring only appear at the very end, so every search scans the whole text.
+	*/
+	struct StringBench
+	{
+		char* pText;
+		char* pTextCopy;
+		char* pSpaces;
+		char* pCopyBuffer;
+		size_t length;
+		size_t numLines;
+	};
+
+	static StringBench s_stringBench;
+
+	static void string_bench_create_text(StringBench* pBench)
+	{
+		static const char* s_words[] = { "vertex", "index", "buffer", "texture", "shader", "mesh", "terrain", "brush", "frame", "camera", "light", "a", "of", "to" };
+
+		pBench->pText = (char*)iol_alloc_raw(BENCH_STRING_TEXT_SIZE + 1);
+		pBench->pTextCopy = (char*)iol_alloc_raw(BENCH_STRING_TEXT_SIZE + 1);
+		pBench->pCopyBuffer = (char*)iol_alloc_raw(BENCH_STRING_TEXT_SIZE + 1);
+		pBench->pSpaces = (char*)iol_alloc_raw(BENCH_STRING_SPACE_SIZE + 2);
+
+		const char* pEndMarker = " needle#";
+		size_t endMarkerLength = strlen(pEndMarker);
+		size_t textLength = BENCH_STRING_TEXT_SIZE - endMarkerLength;
+		size_t lineLength = 0;
+		size_t length = 0;
+		uint64 wordIndex = 0;
+
+		pBench->numLines = 0;
+
+		while (length < textLength)
+		{
+			const char* pWord = s_words[bench::Random(wordIndex++) % iol_countof(s_words)];
+
+			for (; *pWord != '\0' && length < textLength; pWord++, lineLength++)
+				pBench->pText[length++] = *pWord;
+
+			if (length < textLength)
+			{
+				if (lineLength >= 60)
+				{
+					pBench->pText[length++] = '\n';
+					pBench->numLines++;
+					lineLength = 0;
+				}
+				else
+				{
+					pBench->pText[length++] = ' ';
+					lineLength++;
+				}
+			}
+		}
+
+		memcpy(pBench->pText + length, pEndMarker, endMarkerLength);
+		length += endMarkerLength;
+		pBench->pText[length] = '\0';
+		pBench->length = length;
+		pBench->numLines++;
+
+		memcpy(pBench->pTextCopy, pBench->pText, length + 1);
+
+		for (size_t i = 0; i < BENCH_STRING_SPACE_SIZE; i++)
+			pBench->pSpaces[i] = (i % 3 == 0) ? '\t' : ' ';
+
+		pBench->pSpaces[BENCH_STRING_SPACE_SIZE] = 'x';
+		pBench->pSpaces[BENCH_STRING_SPACE_SIZE + 1] = '\0';
+	}
+
+	static void string_bench_get_length(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		// Varying start offsets, so the scans don't always start aligned
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += string::GetLength(pBench->pText + i);
+
+		bench::Consume(sum);
+	}
+
+	static void strlen_bench(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += strlen(pBench->pText + i);
+
+		bench::Consume(sum);
+	}
+
+	static void string_bench_find_char(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += (uint64)(uintptr_t)string::Find(StringView(pBench->pText + i, pBench->length - i), '#');
+
+		bench::Consume(sum);
+	}
+
+	static void memchr_bench(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += (uint64)(uintptr_t)memchr(pBench->pText + i, '#', pBench->length - i);
+
+		bench::Consume(sum);
+	}
+
+	static void string_bench_find_substring(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += (uint64)(uintptr_t)string::Find(StringView(pBench->pText + i, pBench->length - i), StringView("needle#"));
+
+		bench::Consume(sum);
+	}
+
+	static void strstr_bench(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += (uint64)(uintptr_t)strstr(pBench->pText + i, "needle#");
+
+		bench::Consume(sum);
+	}
+
+	static void string_bench_compare(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += string::Compare(pBench->pText + i, pBench->pTextCopy + i) ? 1 : 0;
+
+		bench::Consume(sum);
+	}
+
+	static void string_bench_equals(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += string::Equals(StringView(pBench->pText + i, pBench->length - i), StringView(pBench->pTextCopy + i, pBench->length - i)) ? 1 : 0;
+
+		bench::Consume(sum);
+	}
+
+	static void strcmp_bench(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += strcmp(pBench->pText + i, pBench->pTextCopy + i) == 0 ? 1 : 0;
+
+		bench::Consume(sum);
+	}
+
+	static void string_bench_get_next_line(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 numLines = 0;
+
+		for (const char* pLine = pBench->pText; *pLine != '\0'; pLine = string::GetNextLine(pLine))
+			numLines++;
+
+		bench::Consume(numLines);
+	}
+
+	static void string_bench_split_line(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		StringView view(pBench->pText, pBench->length);
+		uint64 sum = 0;
+
+		while (!view.IsEmpty())
+			sum += string::SplitLine(&view).length;
+
+		bench::Consume(sum);
+	}
+
+	static void strchr_line_bench(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 numLines = 0;
+
+		for (const char* pLine = pBench->pText; pLine != nullptr; numLines++)
+		{
+			pLine = strchr(pLine, '\n');
+
+			if (pLine != nullptr)
+				pLine++;
+		}
+
+		bench::Consume(numLines);
+	}
+
+	static void string_bench_skip(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += (uint64)(uintptr_t)string::Skip(pBench->pSpaces + i, " \t");
+
+		bench::Consume(sum);
+	}
+
+	static void strspn_bench(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+		uint64 sum = 0;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			sum += strspn(pBench->pSpaces + i, " \t");
+
+		bench::Consume(sum);
+	}
+
+	static void string_bench_copy(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			string::Copy(pBench->pCopyBuffer, pBench->pText + i, BENCH_STRING_TEXT_SIZE + 1);
+
+		bench::Consume((uint64)pBench->pCopyBuffer[0]);
+	}
+
+	static void strncpy_bench(void* pUserData)
+	{
+		StringBench* pBench = (StringBench*)pUserData;
+
+		// Limited to the remaining text length, so strncpy doesn't pay for zero padding
+		for (size_t i = 0; i < BENCH_STRING_CALLS; i++)
+			strncpy(pBench->pCopyBuffer, pBench->pText + i, pBench->length - i + 1);
+
+		bench::Consume((uint64)pBench->pCopyBuffer[0]);
+	}
+
+	void bench::RegisterStringBenchmarks()
+	{
+		StringBench* pBench = &s_stringBench;
+		string_bench_create_text(pBench);
+
+		bench::Add("string/get_length/64k", BENCH_STRING_CALLS, pBench, string_bench_get_length);
+		bench::Add("libc/strlen/64k", BENCH_STRING_CALLS, pBench, strlen_bench);
+		bench::Add("string/find_char/64k", BENCH_STRING_CALLS, pBench, string_bench_find_char);
+		bench::Add("libc/memchr/64k", BENCH_STRING_CALLS, pBench, memchr_bench);
+		bench::Add("string/find_substring/64k", BENCH_STRING_CALLS, pBench, string_bench_find_substring);
+		bench::Add("libc/strstr/64k", BENCH_STRING_CALLS, pBench, strstr_bench);
+		bench::Add("string/compare/64k", BENCH_STRING_CALLS, pBench, string_bench_compare);
+		bench::Add("string/equals/64k", BENCH_STRING_CALLS, pBench, string_bench_equals);
+		bench::Add("libc/strcmp/64k", BENCH_STRING_CALLS, pBench, strcmp_bench);
+		bench::Add("string/get_next_line/64k", pBench->numLines, pBench, string_bench_get_next_line);
+		bench::Add("string/split_line/64k", pBench->numLines, pBench, string_bench_split_line);
+		bench::Add("libc/strchr_line/64k", pBench->numLines, pBench, strchr_line_bench);
+		bench::Add("string/skip/4k", BENCH_STRING_CALLS, pBench, string_bench_skip);
+		bench::Add("libc/strspn/4k", BENCH_STRING_CALLS, pBench, strspn_bench);
+		bench::Add("string/copy/64k", BENCH_STRING_CALLS, pBench, string_bench_copy);
+		bench::Add("libc/strncpy/64k", BENCH_STRING_CALLS, pBench, strncpy_bench);
+	}
+
+	void bench::DestroyStringBenchmarks()
+	{
+		StringBench* pBench = &s_stringBench;
+
+		if (pBench->pText == nullptr)
+			return;
+
+		iol_free(pBench->pText);
+		iol_free(pBench->pTextCopy);
+		iol_free(pBench->pSpaces);
+		iol_free(pBench->pCopyBuffer);
+		memory::FillZero(pBench, sizeof(StringBench));
+	}
+}
@@ -0,0 +1,64 @@
+#include "bench.h"
+#include "iol_string.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace iol;
+
+static void print_usage()
+{
+	printf("usage: iolite_bench [--out <file.json>] [--filter <text>] [--repetitions <n>] [--warmups <n>]\n");
+}
+
+int main(int argc, char** argv)
+{
+	bench::Settings settings;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* pArg = argv[i];
+		const char* pValue = i + 1 < argc ? argv[i + 1] : nullptr;
+
+		if (pValue == nullptr)
+		{
+			print_usage();
+			return 1;
+		}
+
+		if (string::Compare(pArg, "--out"))
+			settings.pOutputPath = pValue;
+		else if (string::Compare(pArg, "--filter"))
+			settings.pFilter = pValue;
+		else if (string::Compare(pArg, "--repetitions"))
+			settings.repetitions = (uint32)atoi(pValue);
+		else if (string::Compare(pArg, "--warmups"))
+			settings.warmups = (uint32)atoi(pValue);
+		else
+		{
+			print_usage();
+			return 1;
+		}
+
+		i++;
+	}
+
+	if (settings.repetitions == 0)
+	{
+		print_usage();
+		return 1;
+	}
+
+	bench::RegisterContainerBenchmarks();
+	bench::RegisterStringBenchmarks();
+	bench::RegisterMemoryBenchmarks();
+
+	bool success = bench::RunAll(settings);
+
+	bench::DestroyMemoryBenchmarks();
+	bench::DestroyStringBenchmarks();
+	bench::DestroyContainerBenchmarks();
+	bench::Shutdown();
+
+	return success ? 0 : 1;
+}
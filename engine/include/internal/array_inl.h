@@ -2,6 +2,10 @@
 #define IOLITE_ARRAY_INL_H
 
 #include "iol_array.h"
+#include "iol_core.h"
+
+#include <type_traits>
+#include <utility>
 
 namespace iol
 {
@@ -11,6 +15,9 @@ namespace iol
 		pData = nullptr;
 		capacity = 0;
 		count = 0;
+		pAllocator = nullptr;
+		alignment = 0;
+		flags = ArrayFlags_None;
 	}
 
 	template<typename T>
@@ -19,6 +26,21 @@ namespace iol
 		pData = nullptr;
 		capacity = 0;
 		count = 0;
+		pAllocator = nullptr;
+		alignment = 0;
+		flags = ArrayFlags_None;
+		Create(_capacity);
+	}
+
+	template<typename T>
+	Array<T>::Array(size_t _capacity, Allocator* _pAllocator)
+	{
+		pData = nullptr;
+		capacity = 0;
+		count = 0;
+		pAllocator = _pAllocator;
+		alignment = 0;
+		flags = ArrayFlags_None;
 		Create(_capacity);
 	}
 
@@ -36,17 +58,59 @@ namespace iol
 		if (_capacity == 0)
 			return;
 
-		if (pData == nullptr)
+		if (pData != nullptr && _capacity <= capacity && !IsView())
+			return;
+
+		Destroy();
+
+		pData = AllocateStorage(_capacity);
+		capacity = _capacity;
+	}
+
+	template<typename T>
+	void Array<T>::Create(size_t _capacity, Allocator* _pAllocator)
+	{
+		if (pAllocator != _pAllocator)
 		{
-			pData = iol_alloc_array(T, _capacity);
-			capacity = _capacity;
+			Destroy();
+			pAllocator = _pAllocator;
 		}
-		else if (_capacity > capacity)
+
+		Create(_capacity);
+	}
+
+	template<typename T>
+	void Array<T>::CreateAligned(size_t _capacity, size_t _alignment)
+	{
+		iol_assert(core::IsPowerOfTwo(_alignment));
+
+		if (alignment != _alignment)
 		{
 			Destroy();
-			pData = iol_alloc_array(T, _capacity);
-			capacity = _capacity;
+			alignment = _alignment;
 		}
+
+		Create(_capacity);
+	}
+
+	template<typename T>
+	void Array<T>::CreateGrowable(size_t _capacity)
+	{
+		flags |= ArrayFlags_Growable;
+		Create(_capacity);
+	}
+
+	template<typename T>
+	void Array<T>::CreateView(T* pElements, size_t _count)
+	{
+		iol_assert(pElements != nullptr || _count == 0);
+
+		Destroy();
+
+		pData = pElements;
+		capacity = _count;
+		count = _count;
+		flags |= ArrayFlags_View;
 	}
 
 	template<typename T>
@@ -54,12 +118,15 @@ namespace iol
 	{
 		if (pData != nullptr)
 		{
-			iol_free(pData);
+			if (!IsView())
+				FreeStorage(pData);
+
 			pData = nullptr;
 		}
 
 		capacity = 0;
 		count = 0;
+		flags &= ~ArrayFlags_View;
 	}
 
 	template<typename T>
@@ -68,9 +135,118 @@ namespace iol
 		count = 0;
 	}
 
+	template<typename T>
+	void Array<T>::Reserve(size_t _capacity)
+	{
+		if (_capacity > capacity)
+			Reallocate(_capacity);
+	}
+
+	template<typename T>
+	void Array<T>::Resize(size_t _count)
+	{
+		Reserve(_count);
+
+		for (size_t i = count; i < _count; ++i)
+			new (pData + i) T();
+
+		count = _count;
+	}
+
+	template<typename T>
+	void Array<T>::ShrinkToFit()
+	{
+		if (count == 0)
+		{
+			Destroy();
+			return;
+		}
+
+		if (count < capacity)
+			Reallocate(count);
+	}
+
+	template<typename T>
+	T* Array<T>::AllocateStorage(size_t _capacity)
+	{
+		if (pAllocator != nullptr)
+			return (T*)pAllocator->Allocate(sizeof(T) * _capacity, core::Max(alignof(T), alignment));
+		else if (alignment > 0)
+			return iol_alloc_array_aligned(T, _capacity, alignment);
+		else
+			return iol_alloc_array(T, _capacity);
+	}
+
+	template<typename T>
+	void Array<T>::FreeStorage(T* pStorage)
+	{
+		if (pAllocator != nullptr)
+			pAllocator->Free(pStorage);
+		else if (alignment > 0)
+			iol_free_aligned(pStorage);
+		else
+			iol_free(pStorage);
+	}
+
+	template<typename T>
+	void Array<T>::Reallocate(size_t _capacity)
+	{
+		iol_assert(!IsView());
+		iol_assert(_capacity >= count);
+		iol_assert(_capacity > 0);
+
+		if (pData == nullptr)
+		{
+			pData = AllocateStorage(_capacity);
+		}
+		else if constexpr (std::is_trivially_copyable<T>::value)
+		{
+			// Lets the allocator extend the block in place instead of copying
+			if (pAllocator != nullptr)
+				pData = (T*)pAllocator->Reallocate(pData, sizeof(T) * capacity, sizeof(T) * _capacity, core::Max(alignof(T), alignment));
+			else if (alignment > 0)
+				pData = (T*)iol_realloc_aligned(pData, sizeof(T) * _capacity, alignment);
+			else
+				pData = (T*)iol_realloc(pData, sizeof(T) * _capacity);
+		}
+		else
+		{
+			T* pNewData = AllocateStorage(_capacity);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				new (pNewData + i) T(std::move(pData[i]));
+				pData[i].~T();
+			}
+
+			FreeStorage(pData);
+			pData = pNewData;
+		}
+
+		iol_assert(pData != nullptr);
+		capacity = _capacity;
+	}
+
+	template<typename T>
+	void Array<T>::Grow(size_t minCapacity)
+	{
+		iol_assert(IsGrowable());
+
+		size_t newCapacity = core::Max<size_t>(capacity * 2, ARRAY_MIN_GROW_CAPACITY);
+		Reallocate(core::Max(newCapacity, minCapacity));
+	}
+
 	template<typename T>
 	T& Array<T>::PushBack(const T& element)
 	{
+		if (count == capacity && IsGrowable())
+		{
+			// element may live inside the storage that is about to be reallocated
+			T copy = element;
+			Grow(count + 1);
+			return PushBack(copy);
+		}
+
 		iol_assert(count < capacity);
 
 		T& slot = *(pData + count);
@@ -83,6 +259,9 @@ namespace iol
 	template<typename T>
 	T& Array<T>::PushBack()
 	{
+		if (count == capacity && IsGrowable())
+			Grow(count + 1);
+
 		iol_assert(count < capacity);
 
 		T& slot = *(pData + count);
@@ -94,6 +273,18 @@ namespace iol
 	template<typename T>
 	T* Array<T>::PushBackArray(const T* pElements, size_t a_count)
 	{
+		if (count + a_count > capacity && IsGrowable())
+		{
+			// pElements may point into the storage that is about to be reallocated
+			bool aliased = (uintptr_t)pElements >= (uintptr_t)pData && (uintptr_t)pElements < (uintptr_t)(pData + count);
+			size_t offset = aliased ? (size_t)(pElements - pData) : 0;
+
+			Grow(count + a_count);
+
+			if (aliased)
+				pElements = pData + offset;
+		}
+
 		iol_assert(count + a_count <= capacity);
 
 		T* pSlot = pData + count;
@@ -124,7 +315,7 @@ namespace iol
 		{
 			if (pData[i] == element)
 			{
-				size_t numElementsBehind = count - i;
+				size_t numElementsBehind = count - i - 1;
 
 				if (numElementsBehind > 0)
 				{
@@ -152,10 +343,9 @@ namespace iol
 	template<typename T>
 	void Array<T>::RemoveAt(size_t index)
 	{
-		T* pElement = pData + index;
+		iol_assert(index < count);
 
-		iol_assert(count > 0);
-		iol_assert(pElement >= pData && pElement <= pData + (capacity - 1) * sizeof(T));
+		T* pElement = pData + index;
 
 		size_t numElementsBehind = (pData + count - 1) - pElement;
 
@@ -170,12 +360,9 @@ namespace iol
 	template<typename T>
 	void Array<T>::RemoveAtUnordered(size_t index)
 	{
-		const T* pElement = pData + index;
-
-		iol_assert(count > 0);
-		iol_assert(pElement >= pData && pElement <= pData + (capacity - 1) * sizeof(T));
+		iol_assert(index < count);
 
-		core::Swap(pElement, pData + count - 1);
+		core::Swap(pData + index, pData + count - 1);
 		count--;
 	}
 
@@ -0,0 +1,143 @@
+#ifndef IOLITE_BINARY_STREAM_INL_H
+#define IOLITE_BINARY_STREAM_INL_H
+
+#include "iol_binary_stream.h"
+#include "iol_debug.h"
+
+#include <string.h>
+#include <type_traits>
+
+namespace iol
+{
+	template<typename T>
+	iol_inline T binary_stream_swap_bytes(T value)
+	{
+		uint8 bytes[sizeof(T)];
+		memcpy(bytes, &value, sizeof(T));
+
+		for (size_t i = 0; i < sizeof(T) / 2; i++)
+		{
+			uint8 temp = bytes[i];
+			bytes[i] = bytes[sizeof(T) - 1 - i];
+			bytes[sizeof(T) - 1 - i] = temp;
+		}
+
+		memcpy(&value, bytes, sizeof(T));
+		return value;
+	}
+
+	template<typename T>
+	iol_inline constexpr bool binary_stream_needs_swap()
+	{
+		return BINARY_STREAM_SWAP_BYTES && sizeof(T) > 1 && (std::is_arithmetic<T>::value || std::is_enum<T>::value);
+	}
+
+	//-------------------------------------
+	// BinaryWriter
+	//-------------------------------------
+
+	iol_inline bool BinaryWriter::WriteBytes(const void* pData, size_t size)
+	{
+		if (m_offset + size <= m_capacity && !m_error)
+		{
+			if (size > 0)
+				memcpy(m_pBuffer + m_offset, pData, size);
+
+			m_offset += size;
+			return true;
+		}
+
+		return WriteBytesSlow(pData, size);
+	}
+
+	template<typename T>
+	bool BinaryWriter::Write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter::Write requires a trivially copyable type");
+
+		if constexpr (binary_stream_needs_swap<T>())
+		{
+			T swapped = binary_stream_swap_bytes(value);
+			return WriteBytes(&swapped, sizeof(T));
+		}
+		else
+		{
+			return WriteBytes(&value, sizeof(T));
+		}
+	}
+
+	template<typename T>
+	bool BinaryWriter::WriteArray(const T* pElements, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter::WriteArray requires a trivially copyable type");
+		iol_assert(pElements != nullptr || count == 0);
+
+		if constexpr (binary_stream_needs_swap<T>())
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!Write(pElements[i]))
+					return false;
+			}
+
+			return true;
+		}
+		else
+		{
+			return WriteBytes(pElements, sizeof(T) * count);
+		}
+	}
+
+	//-------------------------------------
+	// BinaryReader
+	//-------------------------------------
+
+	iol_inline bool BinaryReader::ReadBytes(void* pOutData, size_t size)
+	{
+		if (m_offset + size <= m_size && !m_error)
+		{
+			if (size > 0)
+				memcpy(pOutData, m_pBuffer + m_offset, size);
+
+			m_offset += size;
+			return true;
+		}
+
+		return ReadBytesSlow(pOutData, size);
+	}
+
+	template<typename T>
+	bool BinaryReader::Read(T* pOutValue)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "BinaryReader::Read requires a trivially copyable type");
+		iol_assert(pOutValue != nullptr);
+
+		if (!ReadBytes(pOutValue, sizeof(T)))
+			return false;
+
+		if constexpr (binary_stream_needs_swap<T>())
+			*pOutValue = binary_stream_swap_bytes(*pOutValue);
+
+		return true;
+	}
+
+	template<typename T>
+	bool BinaryReader::ReadArray(T* pOutElements, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "BinaryReader::ReadArray requires a trivially copyable type");
+		iol_assert(pOutElements != nullptr || count == 0);
+
+		if (!ReadBytes(pOutElements, sizeof(T) * count))
+			return false;
+
+		if constexpr (binary_stream_needs_swap<T>())
+		{
+			for (size_t i = 0; i < count; i++)
+				pOutElements[i] = binary_stream_swap_bytes(pOutElements[i]);
+		}
+
+		return true;
+	}
+}
+
+#endif // IOLITE_BINARY_STREAM_INL_H
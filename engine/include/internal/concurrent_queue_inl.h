@@ -0,0 +1,259 @@
+#ifndef IOLITE_CONCURRENT_QUEUE_INL_H
+#define IOLITE_CONCURRENT_QUEUE_INL_H
+
+#include "iol_concurrent_queue.h"
+#include "iol_memory.h"
+#include "iol_core.h"
+#include "iol_debug.h"
+
+#include <type_traits>
+
+namespace iol
+{
+	iol_inline void* concurrent_queue_allocate(size_t size, Allocator* pAllocator)
+	{
+		void* pMemory;
+
+		if (pAllocator != nullptr)
+			pMemory = pAllocator->Allocate(size, MEMORY_CACHE_LINE_SIZE);
+		else
+			pMemory = iol_alloc_raw_aligned(size, MEMORY_CACHE_LINE_SIZE);
+
+		iol_assert(pMemory != nullptr);
+		return pMemory;
+	}
+
+	iol_inline void concurrent_queue_free(void* pMemory, Allocator* pAllocator)
+	{
+		if (pAllocator != nullptr)
+			pAllocator->Free(pMemory);
+		else
+			iol_free_aligned(pMemory);
+	}
+
+	//-------------------------------------
+	// SpscQueue
+	//-------------------------------------
+
+	template<typename T>
+	SpscQueue<T>::SpscQueue()
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "SpscQueue only holds trivially copyable elements");
+
+		m_pElements = nullptr;
+		m_capacity = 0;
+		m_mask = 0;
+		m_pAllocator = nullptr;
+		m_tail.store(0, std::memory_order_relaxed);
+		m_cachedHead = 0;
+		m_head.store(0, std::memory_order_relaxed);
+		m_cachedTail = 0;
+	}
+
+	template<typename T>
+	SpscQueue<T>::~SpscQueue()
+	{
+		Destroy();
+	}
+
+	template<typename T>
+	void SpscQueue<T>::Create(size_t capacity, Allocator* pAllocator)
+	{
+		Destroy();
+
+		m_capacity = core::NextPowerOfTwo(core::Max<size_t>(capacity, CONCURRENT_QUEUE_MIN_CAPACITY));
+		m_mask = m_capacity - 1;
+		m_pAllocator = pAllocator;
+		m_pElements = (T*)concurrent_queue_allocate(sizeof(T) * m_capacity, pAllocator);
+	}
+
+	template<typename T>
+	void SpscQueue<T>::Destroy()
+	{
+		if (m_pElements != nullptr)
+			concurrent_queue_free(m_pElements, m_pAllocator);
+
+		m_pElements = nullptr;
+		m_capacity = 0;
+		m_mask = 0;
+		m_tail.store(0, std::memory_order_relaxed);
+		m_cachedHead = 0;
+		m_head.store(0, std::memory_order_relaxed);
+		m_cachedTail = 0;
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::TryPush(const T& element)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+
+		if (tail - m_cachedHead == m_capacity)
+		{
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+
+			if (tail - m_cachedHead == m_capacity)
+				return false;
+		}
+
+		m_pElements[tail & m_mask] = element;
+		m_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T>
+	bool SpscQueue<T>::TryPop(T* pElement)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+
+		if (head == m_cachedTail)
+		{
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+			if (head == m_cachedTail)
+				return false;
+		}
+
+		*pElement = m_pElements[head & m_mask];
+		m_head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T>
+	size_t SpscQueue<T>::GetCount() const
+	{
+		size_t head = m_head.load(std::memory_order_acquire);
+		size_t tail = m_tail.load(std::memory_order_acquire);
+
+		return tail - head <= m_capacity ? tail - head : 0;
+	}
+
+	//-------------------------------------
+	// MpmcQueue
+	//-------------------------------------
+
+	template<typename T>
+	MpmcQueue<T>::MpmcQueue()
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "MpmcQueue only holds trivially copyable elements");
+
+		m_pCells = nullptr;
+		m_capacity = 0;
+		m_mask = 0;
+		m_pAllocator = nullptr;
+		m_enqueuePos.store(0, std::memory_order_relaxed);
+		m_dequeuePos.store(0, std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	MpmcQueue<T>::~MpmcQueue()
+	{
+		Destroy();
+	}
+
+	template<typename T>
+	void MpmcQueue<T>::Create(size_t capacity, Allocator* pAllocator)
+	{
+		Destroy();
+
+		m_capacity = core::NextPowerOfTwo(core::Max<size_t>(capacity, CONCURRENT_QUEUE_MIN_CAPACITY));
+		m_mask = m_capacity - 1;
+		m_pAllocator = pAllocator;
+		m_pCells = (Cell*)concurrent_queue_allocate(sizeof(Cell) * m_capacity, pAllocator);
+
+		// A cell is free for the producer at position p when its sequence is p, and full for the consumer when it is p + 1
+		for (size_t i = 0; i < m_capacity; i++)
+			new (&m_pCells[i].sequence) std::atomic<size_t>(i);
+	}
+
+	template<typename T>
+	void MpmcQueue<T>::Destroy()
+	{
+		if (m_pCells != nullptr)
+			concurrent_queue_free(m_pCells, m_pAllocator);
+
+		m_pCells = nullptr;
+		m_capacity = 0;
+		m_mask = 0;
+		m_enqueuePos.store(0, std::memory_order_relaxed);
+		m_dequeuePos.store(0, std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::TryPush(const T& element)
+	{
+		Cell* pCell;
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			pCell = &m_pCells[pos & m_mask];
+			size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+			if (diff == 0)
+			{
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				return false; // the consumer of the previous round hasn't taken this cell yet
+			}
+			else
+			{
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		pCell->element = element;
+		pCell->sequence.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T>
+	bool MpmcQueue<T>::TryPop(T* pElement)
+	{
+		Cell* pCell;
+		size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			pCell = &m_pCells[pos & m_mask];
+			size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+			if (diff == 0)
+			{
+				if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				return false; // no producer has filled this cell yet
+			}
+			else
+			{
+				pos = m_dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		*pElement = pCell->element;
+		pCell->sequence.store(pos + m_capacity, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T>
+	size_t MpmcQueue<T>::GetCount() const
+	{
+		size_t dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+		size_t enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+
+		return enqueuePos - dequeuePos <= m_capacity ? enqueuePos - dequeuePos : 0;
+	}
+}
+
+#endif // IOLITE_CONCURRENT_QUEUE_INL_H
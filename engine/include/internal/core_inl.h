@@ -1,8 +1,58 @@
 #ifndef IOLITE_CORE_INL_H
 #define IOLITE_CORE_INL_H
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace iol
 {
+	iol_inline size_t core::NextPowerOfTwo(size_t value)
+	{
+		if (value <= 1)
+			return 1;
+
+		return (size_t)1 << (64 - CountLeadingZeros((uint64)value - 1));
+	}
+
+	// value must not be 0
+	iol_inline uint32 core::CountTrailingZeros(uint64 value)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return (uint32)index;
+#else
+		return (uint32)__builtin_ctzll(value);
+#endif
+	}
+
+	// value must not be 0
+	iol_inline uint32 core::CountLeadingZeros(uint64 value)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return 63 - (uint32)index;
+#else
+		return (uint32)__builtin_clzll(value);
+#endif
+	}
+
+	iol_inline uint32 core::PopCount(uint64 value)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		return (uint32)__popcnt64(value);
+#elif defined(_MSC_VER)
+		value = value - ((value >> 1) & 0x5555555555555555ull);
+		value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+		value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return (uint32)((value * 0x0101010101010101ull) >> 56);
+#else
+		return (uint32)__builtin_popcountll(value);
+#endif
+	}
+
 	template<typename T>
 	T core::Min(T a, T b)
 	{
@@ -0,0 +1,495 @@
+#ifndef IOL_FLAT_HASHMAP_INL_H
+#define IOL_FLAT_HASHMAP_INL_H
+
+#include "iol_flat_hashmap.h"
+#include "iol_memory.h"
+#include "iol_core.h"
+#include "iol_debug.h"
+
+#include <type_traits>
+#include <utility>
+
+#if defined(IOL_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(IOL_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#define FLAT_HASHMAP_CONTROL_EMPTY ((int8)-128)
+#define FLAT_HASHMAP_CONTROL_DELETED ((int8)-2)
+
+// The match functions return one bit per slot for SSE2 and one nibble per slot for NEON
+#ifdef IOL_SIMD_NEON
+#define FLAT_HASHMAP_MASK_SHIFT 2
+#else
+#define FLAT_HASHMAP_MASK_SHIFT 0
+#endif
+
+namespace iol
+{
+#if defined(IOL_SIMD_SSE2)
+	iol_inline uint64 flat_hashmap_match(const int8* pGroup, int8 h2)
+	{
+		__m128i control = _mm_loadu_si128((const __m128i*)pGroup);
+		return (uint64)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(h2)));
+	}
+
+	iol_inline uint64 flat_hashmap_match_empty(const int8* pGroup)
+	{
+		return flat_hashmap_match(pGroup, FLAT_HASHMAP_CONTROL_EMPTY);
+	}
+
+	iol_inline uint64 flat_hashmap_match_empty_or_deleted(const int8* pGroup)
+	{
+		// Empty and deleted are the only control bytes with the sign bit set
+		__m128i control = _mm_loadu_si128((const __m128i*)pGroup);
+		return (uint64)_mm_movemask_epi8(control);
+	}
+
+	iol_inline uint64 flat_hashmap_match_full(const int8* pGroup)
+	{
+		return flat_hashmap_match_empty_or_deleted(pGroup) ^ 0xFFFF;
+	}
+#elif defined(IOL_SIMD_NEON)
+	iol_inline uint64 flat_hashmap_neon_to_mask(uint8x16_t comparison)
+	{
+		// Narrow every byte to a nibble and keep one bit per nibble
+		uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(comparison), 4);
+		return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull;
+	}
+
+	iol_inline uint64 flat_hashmap_match(const int8* pGroup, int8 h2)
+	{
+		int8x16_t control = vld1q_s8(pGroup);
+		return flat_hashmap_neon_to_mask(vceqq_s8(control, vdupq_n_s8(h2)));
+	}
+
+	iol_inline uint64 flat_hashmap_match_empty(const int8* pGroup)
+	{
+		return flat_hashmap_match(pGroup, FLAT_HASHMAP_CONTROL_EMPTY);
+	}
+
+	iol_inline uint64 flat_hashmap_match_empty_or_deleted(const int8* pGroup)
+	{
+		int8x16_t control = vld1q_s8(pGroup);
+		return flat_hashmap_neon_to_mask(vcltq_s8(control, vdupq_n_s8(0)));
+	}
+
+	iol_inline uint64 flat_hashmap_match_full(const int8* pGroup)
+	{
+		int8x16_t control = vld1q_s8(pGroup);
+		return flat_hashmap_neon_to_mask(vcgeq_s8(control, vdupq_n_s8(0)));
+	}
+#else
+	iol_inline uint64 flat_hashmap_match(const int8* pGroup, int8 h2)
+	{
+		uint64 mask = 0;
+
+		for (uint32 i = 0; i < FLAT_HASHMAP_GROUP_WIDTH; i++)
+		{
+			if (pGroup[i] == h2)
+				mask |= (uint64)1 << i;
+		}
+
+		return mask;
+	}
+
+	iol_inline uint64 flat_hashmap_match_empty(const int8* pGroup)
+	{
+		return flat_hashmap_match(pGroup, FLAT_HASHMAP_CONTROL_EMPTY);
+	}
+
+	iol_inline uint64 flat_hashmap_match_empty_or_deleted(const int8* pGroup)
+	{
+		uint64 mask = 0;
+
+		for (uint32 i = 0; i < FLAT_HASHMAP_GROUP_WIDTH; i++)
+		{
+			if (pGroup[i] < 0)
+				mask |= (uint64)1 << i;
+		}
+
+		return mask;
+	}
+
+	iol_inline uint64 flat_hashmap_match_full(const int8* pGroup)
+	{
+		return flat_hashmap_match_empty_or_deleted(pGroup) ^ 0xFFFF;
+	}
+#endif
+
+	iol_inline size_t flat_hashmap_first_index(uint64 mask)
+	{
+		return core::CountTrailingZeros(mask) >> FLAT_HASHMAP_MASK_SHIFT;
+	}
+
+	iol_inline size_t flat_hashmap_last_index(uint64 mask)
+	{
+		return (63 - core::CountLeadingZeros(mask)) >> FLAT_HASHMAP_MASK_SHIFT;
+	}
+
+	// Maximum number of elements before the table grows, keeps the load factor at 7/8
+	iol_inline size_t flat_hashmap_max_load(size_t capacity)
+	{
+		return capacity - capacity / 8;
+	}
+
+	template<typename TKey, typename TValue>
+	FlatHashmap<TKey, TValue>::FlatHashmap()
+	{
+		m_hashFunction = nullptr;
+		m_pAllocator = nullptr;
+		m_pControl = nullptr;
+		m_pSlots = nullptr;
+		m_capacity = 0;
+		m_count = 0;
+		m_growthLeft = 0;
+	}
+
+	template<typename TKey, typename TValue>
+	FlatHashmap<TKey, TValue>::~FlatHashmap()
+	{
+		Destroy();
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::Create(size_t capacity, Allocator* pAllocator)
+	{
+		Create(Hash<TKey>::Get, capacity, pAllocator);
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::Create(uint32(*hashFunction)(const TKey& key), size_t capacity, Allocator* pAllocator)
+	{
+		iol_assert(m_pControl == nullptr);
+		iol_assert(hashFunction != nullptr);
+
+		m_hashFunction = hashFunction;
+		m_pAllocator = pAllocator;
+		Reserve(capacity);
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::Destroy()
+	{
+		if (m_pControl != nullptr)
+		{
+			Clear();
+			FreeTable(m_pControl);
+		}
+
+		m_pControl = nullptr;
+		m_pSlots = nullptr;
+		m_capacity = 0;
+		m_count = 0;
+		m_growthLeft = 0;
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::Clear()
+	{
+		if (m_pControl == nullptr)
+			return;
+
+		if constexpr (!std::is_trivially_destructible<Slot>::value)
+		{
+			for (size_t i = 0; i < m_capacity; i++)
+			{
+				if (m_pControl[i] >= 0)
+					m_pSlots[i].~Slot();
+			}
+		}
+
+		memory::Fill(m_pControl, m_capacity + FLAT_HASHMAP_GROUP_WIDTH, FLAT_HASHMAP_CONTROL_EMPTY);
+		m_count = 0;
+		m_growthLeft = flat_hashmap_max_load(m_capacity);
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::Reserve(size_t count)
+	{
+		size_t capacity = core::Max<size_t>(core::NextPowerOfTwo(count), FLAT_HASHMAP_MIN_CAPACITY);
+
+		while (flat_hashmap_max_load(capacity) < count)
+			capacity *= 2;
+
+		if (capacity > m_capacity)
+			Rehash(capacity);
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::Add(const TKey& key, const TValue& value)
+	{
+		iol_assert(m_pControl != nullptr);
+
+		uint64 hash = HashKey(key);
+		size_t index = Find(key, hash);
+
+		if (index != m_capacity)
+		{
+			m_pSlots[index].value = value;
+			return;
+		}
+
+		index = FindInsertSlot(hash);
+
+		if (m_growthLeft == 0 && m_pControl[index] != FLAT_HASHMAP_CONTROL_DELETED)
+		{
+			// Grow if the table is really full, otherwise the rehash only drops the deleted slots
+			size_t newCapacity = (m_count + 1 > flat_hashmap_max_load(m_capacity) / 2) ? m_capacity * 2 : m_capacity;
+			Rehash(newCapacity);
+			index = FindInsertSlot(hash);
+		}
+
+		if (m_pControl[index] == FLAT_HASHMAP_CONTROL_EMPTY)
+			m_growthLeft--;
+
+		SetControl(index, (int8)(hash & 0x7F));
+		new (&m_pSlots[index].key) TKey(key);
+		new (&m_pSlots[index].value) TValue(value);
+		m_count++;
+	}
+
+	template<typename TKey, typename TValue>
+	bool FlatHashmap<TKey, TValue>::Remove(const TKey& key)
+	{
+		if (m_count == 0)
+			return false;
+
+		size_t index = Find(key, HashKey(key));
+
+		if (index == m_capacity)
+			return false;
+
+		m_pSlots[index].~Slot();
+
+		// Lookups stop at the first group with an empty slot, so a slot in a group that never was full can become empty again
+		size_t indexBefore = (index - FLAT_HASHMAP_GROUP_WIDTH) & (m_capacity - 1);
+		uint64 emptyAfter = flat_hashmap_match_empty(m_pControl + index);
+		uint64 emptyBefore = flat_hashmap_match_empty(m_pControl + indexBefore);
+		bool wasNeverFull = emptyBefore != 0 && emptyAfter != 0
+			&& flat_hashmap_first_index(emptyAfter) + (FLAT_HASHMAP_GROUP_WIDTH - 1 - flat_hashmap_last_index(emptyBefore)) < FLAT_HASHMAP_GROUP_WIDTH;
+
+		if (wasNeverFull)
+		{
+			SetControl(index, FLAT_HASHMAP_CONTROL_EMPTY);
+			m_growthLeft++;
+		}
+		else
+		{
+			SetControl(index, FLAT_HASHMAP_CONTROL_DELETED);
+		}
+
+		m_count--;
+
+		return true;
+	}
+
+	template<typename TKey, typename TValue>
+	TValue* FlatHashmap<TKey, TValue>::Get(const TKey& key) const
+	{
+		if (m_count == 0)
+			return nullptr;
+
+		size_t index = Find(key, HashKey(key));
+
+		if (index == m_capacity)
+			return nullptr;
+
+		return &m_pSlots[index].value;
+	}
+
+	template<typename TKey, typename TValue>
+	uint64 FlatHashmap<TKey, TValue>::HashKey(const TKey& key) const
+	{
+		// The user hash is often weak in the low or high bits, spread it over all 64 bits
+		return hash::Mix64(m_hashFunction(key));
+	}
+
+	template<typename TKey, typename TValue>
+	size_t FlatHashmap<TKey, TValue>::Find(const TKey& key, uint64 hash) const
+	{
+		size_t mask = m_capacity - 1;
+		size_t position = (size_t)(hash >> 7) & mask;
+		int8 h2 = (int8)(hash & 0x7F);
+		size_t stride = 0;
+
+		while (true)
+		{
+			const int8* pGroup = m_pControl + position;
+
+			for (uint64 matches = flat_hashmap_match(pGroup, h2); matches != 0; matches &= matches - 1)
+			{
+				size_t index = (position + flat_hashmap_first_index(matches)) & mask;
+
+				if (m_pSlots[index].key == key)
+					return index;
+			}
+
+			if (flat_hashmap_match_empty(pGroup) != 0)
+				return m_capacity;
+
+			// Triangular probing visits every group once for power of two capacities
+			stride += FLAT_HASHMAP_GROUP_WIDTH;
+			position = (position + stride) & mask;
+			iol_assert(stride <= m_capacity);
+		}
+	}
+
+	template<typename TKey, typename TValue>
+	size_t FlatHashmap<TKey, TValue>::FindInsertSlot(uint64 hash) const
+	{
+		size_t mask = m_capacity - 1;
+		size_t position = (size_t)(hash >> 7) & mask;
+		size_t stride = 0;
+
+		while (true)
+		{
+			uint64 matches = flat_hashmap_match_empty_or_deleted(m_pControl + position);
+
+			if (matches != 0)
+				return (position + flat_hashmap_first_index(matches)) & mask;
+
+			stride += FLAT_HASHMAP_GROUP_WIDTH;
+			position = (position + stride) & mask;
+			iol_assert(stride <= m_capacity);
+		}
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::SetControl(size_t index, int8 control)
+	{
+		m_pControl[index] = control;
+
+		// Keep the mirrored first group in sync, so a group load never has to wrap around
+		if (index < FLAT_HASHMAP_GROUP_WIDTH)
+			m_pControl[m_capacity + index] = control;
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::Rehash(size_t newCapacity)
+	{
+		iol_assert(core::IsPowerOfTwo(newCapacity));
+		iol_assert(flat_hashmap_max_load(newCapacity) >= m_count);
+
+		int8* pOldControl = m_pControl;
+		Slot* pOldSlots = m_pSlots;
+		size_t oldCapacity = m_capacity;
+
+		AllocateTable(newCapacity);
+
+		for (size_t i = 0; i < oldCapacity; i++)
+		{
+			if (pOldControl[i] < 0)
+				continue;
+
+			Slot& oldSlot = pOldSlots[i];
+			uint64 hash = HashKey(oldSlot.key);
+			size_t index = FindInsertSlot(hash);
+
+			SetControl(index, (int8)(hash & 0x7F));
+			new (&m_pSlots[index].key) TKey(std::move(oldSlot.key));
+			new (&m_pSlots[index].value) TValue(std::move(oldSlot.value));
+			oldSlot.~Slot();
+		}
+
+		m_growthLeft = flat_hashmap_max_load(m_capacity) - m_count;
+
+		if (pOldControl != nullptr)
+			FreeTable(pOldControl);
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::AllocateTable(size_t capacity)
+	{
+		// Control bytes and slots share one allocation
+		size_t controlSize = core::Align(capacity + FLAT_HASHMAP_GROUP_WIDTH, alignof(Slot));
+		size_t size = controlSize + sizeof(Slot) * capacity;
+		size_t alignment = core::Max<size_t>(alignof(Slot), MEMORY_ALIGNMENT_DEFAULT);
+		uint8* pTable;
+
+		if (m_pAllocator != nullptr)
+			pTable = (uint8*)m_pAllocator->Allocate(size, alignment);
+		else
+			pTable = (uint8*)iol_alloc_raw_aligned(size, alignment);
+
+		iol_assert(pTable != nullptr);
+
+		m_pControl = (int8*)pTable;
+		m_pSlots = (Slot*)(pTable + controlSize);
+		m_capacity = capacity;
+		memory::Fill(m_pControl, capacity + FLAT_HASHMAP_GROUP_WIDTH, FLAT_HASHMAP_CONTROL_EMPTY);
+	}
+
+	template<typename TKey, typename TValue>
+	void FlatHashmap<TKey, TValue>::FreeTable(int8* pControl)
+	{
+		if (m_pAllocator != nullptr)
+			m_pAllocator->Free(pControl);
+		else
+			iol_free_aligned(pControl);
+	}
+
+	template<typename TKey, typename TValue>
+	typename FlatHashmap<TKey, TValue>::Iterator FlatHashmap<TKey, TValue>::GetIterator() const
+	{
+		FlatHashmap<TKey, TValue>::Iterator it;
+		it.index = 0;
+		it.pControl = m_pControl;
+		it.pSlots = m_pSlots;
+		it.capacity = m_capacity;
+
+		if (m_capacity > 0 && m_pControl[0] < 0)
+			it.Increment();
+
+		return it;
+	}
+
+	template<typename TKey, typename TValue>
+	TValue& FlatHashmap<TKey, TValue>::Iterator::GetValue() const
+	{
+		return pSlots[index].value;
+	}
+
+	template<typename TKey, typename TValue>
+	TKey& FlatHashmap<TKey, TValue>::Iterator::GetKey() const
+	{
+		return pSlots[index].key;
+	}
+
+	template<typename TKey, typename TValue>
+	bool FlatHashmap<TKey, TValue>::Iterator::Increment()
+	{
+		index++;
+
+		while (index < capacity)
+		{
+			// Bytes past the end belong to the mirrored first group and are cut off by the capacity check
+			uint64 full = flat_hashmap_match_full(pControl + index);
+
+			if (full != 0)
+			{
+				index += flat_hashmap_first_index(full);
+				break;
+			}
+
+			index += FLAT_HASHMAP_GROUP_WIDTH;
+		}
+
+		if (index >= capacity)
+		{
+			index = capacity;
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename TKey, typename TValue>
+	bool FlatHashmap<TKey, TValue>::Iterator::IsValid() const
+	{
+		return index < capacity;
+	}
+}
+
+#endif // IOL_FLAT_HASHMAP_INL_H
@@ -3,6 +3,8 @@
 
 #include "iol_hashmap.h"
 #include "iol_memory.h"
+#include "iol_core.h"
+#include "iol_debug.h"
 
 namespace iol
 {
@@ -13,6 +15,7 @@ namespace iol
 		m_lists = nullptr;
 		m_numLists = 0;
 		m_count = 0;
+		m_pAllocator = nullptr;
 	}
 
 	template<typename TKey, typename TValue>
@@ -22,30 +25,43 @@ namespace iol
 	}
 
 	template<typename TKey, typename TValue>
-	void Hashmap<TKey, TValue>::Create(uint32(*hashFunction)(const TKey& key), size_t capacity)
+	void Hashmap<TKey, TValue>::Create(size_t capacity, Allocator* pAllocator)
+	{
+		Create(Hash<TKey>::Get, capacity, pAllocator);
+	}
+
+	template<typename TKey, typename TValue>
+	void Hashmap<TKey, TValue>::Create(uint32(*hashFunction)(const TKey& key), size_t capacity, Allocator* pAllocator)
 	{
 		m_hashFunction = hashFunction;
 		m_numLists = capacity;
-		m_lists = iol_alloc_array(Element*, capacity);
+		m_pAllocator = pAllocator;
+
+		if (pAllocator != nullptr)
+			m_lists = (Element**)pAllocator->Allocate(sizeof(Element*) * capacity, alignof(Element*));
+		else
+			m_lists = iol_alloc_array(Element*, capacity);
+
 		memory::FillZero(m_lists, sizeof(Element*) * capacity);
+		m_elementPool.Create(sizeof(Element), core::Min<size_t>(capacity, 1024), alignof(Element), pAllocator);
 	}
 
 	template<typename TKey, typename TValue>
 	void Hashmap<TKey, TValue>::Destroy()
 	{
-		for (size_t i = 0; i < m_numLists; i++)
+		// All elements live in the pool, no need to walk the lists
+		m_elementPool.Destroy();
+
+		if (m_lists != nullptr)
 		{
-			Element* element = m_lists[i];
+			if (m_pAllocator != nullptr)
+				m_pAllocator->Free(m_lists);
+			else
+				iol_free(m_lists);
 
-			while (element)
-			{
-				Element* prev = element;
-				element = element->pNext;
-				iol_free(prev);
-			}
+			m_lists = nullptr;
 		}
 
-		iol_free(m_lists);
 		m_numLists = 0;
 		m_count = 0;
 	}
@@ -54,41 +70,26 @@ namespace iol
 	void Hashmap<TKey, TValue>::Add(const TKey& key, const TValue& value)
 	{
 		uint32 listIndex = m_hashFunction(key) % m_numLists;
-		
-		if (m_lists[listIndex] == nullptr)
-		{
-			Element* newElement = iol_alloc(Element);
-			newElement->pNext = nullptr;
-			newElement->key = key;
-			newElement->value = value;
+		Element** ppLink = &m_lists[listIndex];
 
-			m_lists[listIndex] = newElement;
-			m_count++;
-		}
-		else
+		while (*ppLink)
 		{
-			Element* current = m_lists[listIndex];
-
-			if (current->key == key)
+			if ((*ppLink)->key == key)
 			{
-				current->value = value;
-			}
-			else
-			{
-				while (current->pNext)
-				{
-					current = current->pNext;
-				}
-
-				Element* newElement = iol_alloc(Element);
-				newElement->pNext = nullptr;
-				newElement->key = key;
-				newElement->value = value;
-
-				current->pNext = newElement;
-				m_count++;
+				(*ppLink)->value = value;
+				return;
 			}
+
+			ppLink = &(*ppLink)->pNext;
 		}
+
+		Element* newElement = (Element*)m_elementPool.Allocate();
+		newElement->pNext = nullptr;
+		newElement->key = key;
+		newElement->value = value;
+
+		*ppLink = newElement;
+		m_count++;
 	}
 
 	template<typename TKey, typename TValue>
@@ -108,13 +109,10 @@ namespace iol
 			{
 				if (prev)
 					prev->pNext = current->pNext;
+				else
+					m_lists[listIndex] = current->pNext;
 
-				if (!prev && !current->pNext)
-				{
-					m_lists[listIndex] = nullptr;
-				}
-
-				iol_free(current);
+				m_elementPool.Free(current);
 				iol_assert(m_count > 0);
 				m_count--;
 
@@ -3,20 +3,48 @@
 
 #include "iol_definitions.h"
 
-#ifndef MEMORY_MAX_TRACKED_ALLOCATIONS
-#define MEMORY_MAX_TRACKED_ALLOCATIONS 100 * 1024
+#ifndef MEMORY_TRACKING_INITIAL_CAPACITY
+#define MEMORY_TRACKING_INITIAL_CAPACITY 4 * 1024
 #endif
 
 #ifndef MEMORY_ALIGNMENT_DEFAULT
 #define MEMORY_ALIGNMENT_DEFAULT 16
 #endif
 
+#ifndef MEMORY_CACHE_LINE_SIZE
+#define MEMORY_CACHE_LINE_SIZE 64
+#endif
+
+#ifndef MEMORY_HUGE_PAGE_SIZE
+#define MEMORY_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+// Space in front of iol_new_array allocations that holds the element count, keeps the elements default aligned
+#define MEMORY_ARRAY_HEADER_SIZE MEMORY_ALIGNMENT_DEFAULT
+
+#ifndef MEMORY_POOL_MAX_BLOCKS_PER_CHUNK
+#define MEMORY_POOL_MAX_BLOCKS_PER_CHUNK 64 * 1024
+#endif
+
 namespace iol
 {
 	void*            memory_allocate(size_t size);
 	void             memory_free(void* pMemory);
 	void*            memory_realloc(void* pMemory, size_t newSize);
 
+	// Memory from the aligned functions must only be released with memory_free_aligned.
+	void*            memory_allocate_aligned(size_t size, size_t alignment);
+	void             memory_free_aligned(void* pMemory);
+	void*            memory_realloc_aligned(void* pMemory, size_t newSize, size_t alignment);
+
+	// Size of a single object allocated by iol_new, which only guarantees MEMORY_ALIGNMENT_DEFAULT
+	template<typename T>
+	constexpr size_t memory_new_size()
+	{
+		static_assert(alignof(T) <= MEMORY_ALIGNMENT_DEFAULT, "over-aligned type, use iol_alloc_aligned with placement new");
+		return sizeof(T);
+	}
+
 	template<typename T>
 	void memory_delete(T* pMemory)
 	{
@@ -27,47 +55,51 @@ namespace iol
 	template<typename T>
 	T* memory_new_array(size_t count)
 	{
-		size_t* ptr = (size_t*)memory_allocate(sizeof(size_t) + sizeof(T) * count);
-		*ptr = count;
-		ptr++;
-		T* arr = (T*)ptr;
+		static_assert(alignof(T) <= MEMORY_ALIGNMENT_DEFAULT, "over-aligned type, use iol_alloc_array_aligned");
+		static_assert(MEMORY_ARRAY_HEADER_SIZE >= sizeof(size_t), "array header too small");
+
+		uint8* pBase = (uint8*)memory_allocate(MEMORY_ARRAY_HEADER_SIZE + sizeof(T) * count);
+		T* arr = (T*)(pBase + MEMORY_ARRAY_HEADER_SIZE);
+		*((size_t*)arr - 1) = count;
 		return arr;
 	}
 
 	template<typename T>
 	void memory_delete_array(T* arr)
 	{
-		size_t* ptr = (size_t*)arr;
-		ptr--;
-		size_t count = *ptr;
+		size_t count = *((size_t*)arr - 1);
 
 		for (size_t i = 0; i < count; i++)
 			(arr + i)->~T();
 
-		memory_free(ptr);
+		memory_free((uint8*)arr - MEMORY_ARRAY_HEADER_SIZE);
 	}
 
 #ifndef IOL_MASTER
 
+	// Call site of an allocation, interned once per unique file/line pair.
+	struct AllocationSite
+	{
+		const char* pFile;
+		size_t line;
+	};
+
 	struct AllocationInfo
 	{
-		bool slotUsed;
 		void* pMemory;
 		size_t size;
-		char fileLineString[512];
+		uint32 siteIndex;
 	};
 
-	extern AllocationInfo g_allocations[MEMORY_MAX_TRACKED_ALLOCATIONS];
-
-	void             memory_alloc_info_set(AllocationInfo* pInfo, const char* pFile, size_t line, void* _pMemory, size_t _size);
-	void             memory_alloc_info_clear(AllocationInfo* pInfo);
-	AllocationInfo*  memory_alloc_info_get_free();
-	AllocationInfo*  memory_alloc_info_get(void* pMemory);
-	size_t           memory_alloc_info_get_all(AllocationInfo* pOutAllocations, size_t outMaxAllocations);
 	void             memory_alloc_info_add(const char* pFile, size_t line, void* pMemory, size_t size);
 	void             memory_alloc_info_remove(const char* pFile, size_t line, void* pMemory);
+	size_t           memory_alloc_info_get_count();
 	void*            memory_alloc_helper(const char* pFile, size_t line, size_t size);
 	void             memory_free_helper(const char* pFile, size_t line, void* pMemory);
+	void*            memory_realloc_helper(const char* pFile, size_t line, void* pMemory, size_t newSize);
+	void*            memory_alloc_aligned_helper(const char* pFile, size_t line, size_t size, size_t alignment);
+	void             memory_free_aligned_helper(const char* pFile, size_t line, void* pMemory);
+	void*            memory_realloc_aligned_helper(const char* pFile, size_t line, void* pMemory, size_t newSize, size_t alignment);
 
 	template<typename T>
 	T* memory_new_array_helper(const char* pFile, size_t line, size_t count)
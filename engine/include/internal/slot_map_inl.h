@@ -0,0 +1,277 @@
+#ifndef IOLITE_SLOT_MAP_INL_H
+#define IOLITE_SLOT_MAP_INL_H
+
+#include "iol_slot_map.h"
+#include "iol_memory.h"
+#include "iol_core.h"
+#include "iol_debug.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace iol
+{
+	iol_inline uint32 slot_map_next_generation(uint32 generation)
+	{
+		generation = (generation + 1) & SLOT_MAP_GENERATION_MASK;
+		return generation != 0 ? generation : 1;
+	}
+
+	template<typename T>
+	SlotMap<T>::SlotMap()
+	{
+		m_pAllocator = nullptr;
+		m_pElements = nullptr;
+		m_pSlotIndices = nullptr;
+		m_pSlots = nullptr;
+		m_capacity = 0;
+		m_count = 0;
+		m_numSlots = 0;
+		m_freeHead = SLOT_MAP_INVALID_INDEX;
+		m_freeTail = SLOT_MAP_INVALID_INDEX;
+	}
+
+	template<typename T>
+	SlotMap<T>::~SlotMap()
+	{
+		Destroy();
+	}
+
+	template<typename T>
+	void SlotMap<T>::Create(size_t capacity, Allocator* pAllocator)
+	{
+		Destroy();
+
+		m_pAllocator = pAllocator;
+
+		if (capacity > 0)
+			Reallocate(core::Max<size_t>(capacity, SLOT_MAP_MIN_CAPACITY));
+	}
+
+	template<typename T>
+	void SlotMap<T>::Destroy()
+	{
+		if (m_pElements != nullptr)
+		{
+			if constexpr (!std::is_trivially_destructible<T>::value)
+			{
+				for (size_t i = 0; i < m_count; i++)
+					m_pElements[i].~T();
+			}
+
+			if (m_pAllocator != nullptr)
+				m_pAllocator->Free(m_pElements);
+			else
+				iol_free_aligned(m_pElements);
+		}
+
+		m_pElements = nullptr;
+		m_pSlotIndices = nullptr;
+		m_pSlots = nullptr;
+		m_capacity = 0;
+		m_count = 0;
+		m_numSlots = 0;
+		m_freeHead = SLOT_MAP_INVALID_INDEX;
+		m_freeTail = SLOT_MAP_INVALID_INDEX;
+	}
+
+	template<typename T>
+	void SlotMap<T>::Clear()
+	{
+		// The slots stay allocated with bumped generations, so handles from before the Clear stay invalid
+		for (size_t i = 0; i < m_count; i++)
+		{
+			if constexpr (!std::is_trivially_destructible<T>::value)
+				m_pElements[i].~T();
+
+			uint32 slotIndex = m_pSlotIndices[i];
+			m_pSlots[slotIndex].generation = slot_map_next_generation(m_pSlots[slotIndex].generation);
+			AddFreeSlot(slotIndex);
+		}
+
+		m_count = 0;
+	}
+
+	template<typename T>
+	void SlotMap<T>::Reserve(size_t capacity)
+	{
+		if (capacity > m_capacity)
+			Reallocate(capacity);
+	}
+
+	template<typename T>
+	Handle<T> SlotMap<T>::Add(const T& element)
+	{
+		if (m_count == m_capacity)
+		{
+			// element may live inside the storage that is about to be reallocated
+			T copy(element);
+			Reallocate(core::Max<size_t>(m_capacity * 2, SLOT_MAP_MIN_CAPACITY));
+			return Add(std::move(copy));
+		}
+
+		return Add(T(element));
+	}
+
+	template<typename T>
+	Handle<T> SlotMap<T>::Add(T&& element)
+	{
+		if (m_count == m_capacity)
+		{
+			T temp(std::move(element));
+			Reallocate(core::Max<size_t>(m_capacity * 2, SLOT_MAP_MIN_CAPACITY));
+			return Add(std::move(temp));
+		}
+
+		uint32 slotIndex;
+
+		if (m_freeHead != SLOT_MAP_INVALID_INDEX)
+		{
+			slotIndex = m_freeHead;
+			m_freeHead = m_pSlots[slotIndex].index;
+
+			if (m_freeHead == SLOT_MAP_INVALID_INDEX)
+				m_freeTail = SLOT_MAP_INVALID_INDEX;
+		}
+		else
+		{
+			slotIndex = m_numSlots++;
+			m_pSlots[slotIndex].generation = 1;
+		}
+
+		Slot& slot = m_pSlots[slotIndex];
+		slot.index = (uint32)m_count;
+		m_pSlotIndices[m_count] = slotIndex;
+		new (m_pElements + m_count) T(std::move(element));
+		m_count++;
+
+		Handle<T> handle;
+		handle.value = (slot.generation << SLOT_MAP_INDEX_BITS) | slotIndex;
+		return handle;
+	}
+
+	template<typename T>
+	bool SlotMap<T>::Remove(Handle<T> handle)
+	{
+		Slot* pSlot = FindSlot(handle);
+
+		if (pSlot == nullptr)
+			return false;
+
+		uint32 index = pSlot->index;
+		uint32 lastIndex = (uint32)m_count - 1;
+
+		if (index != lastIndex)
+		{
+			uint32 movedSlotIndex = m_pSlotIndices[lastIndex];
+
+			m_pElements[index] = std::move(m_pElements[lastIndex]);
+			m_pSlotIndices[index] = movedSlotIndex;
+			m_pSlots[movedSlotIndex].index = index;
+		}
+
+		m_pElements[lastIndex].~T();
+		m_count--;
+
+		pSlot->generation = slot_map_next_generation(pSlot->generation);
+		AddFreeSlot(handle.GetIndex());
+
+		return true;
+	}
+
+	template<typename T>
+	T* SlotMap<T>::Get(Handle<T> handle) const
+	{
+		Slot* pSlot = FindSlot(handle);
+		return pSlot != nullptr ? m_pElements + pSlot->index : nullptr;
+	}
+
+	template<typename T>
+	Handle<T> SlotMap<T>::GetHandle(size_t denseIndex) const
+	{
+		iol_assert(denseIndex < m_count);
+
+		uint32 slotIndex = m_pSlotIndices[denseIndex];
+
+		Handle<T> handle;
+		handle.value = (m_pSlots[slotIndex].generation << SLOT_MAP_INDEX_BITS) | slotIndex;
+		return handle;
+	}
+
+	template<typename T>
+	typename SlotMap<T>::Slot* SlotMap<T>::FindSlot(Handle<T> handle) const
+	{
+		uint32 slotIndex = handle.GetIndex();
+
+		// Free slots already carry the generation of their next element, no handle with it exists yet
+		if (slotIndex >= m_numSlots || m_pSlots[slotIndex].generation != handle.GetGeneration())
+			return nullptr;
+
+		return m_pSlots + slotIndex;
+	}
+
+	template<typename T>
+	void SlotMap<T>::AddFreeSlot(uint32 slotIndex)
+	{
+		m_pSlots[slotIndex].index = SLOT_MAP_INVALID_INDEX;
+
+		if (m_freeTail != SLOT_MAP_INVALID_INDEX)
+			m_pSlots[m_freeTail].index = slotIndex;
+		else
+			m_freeHead = slotIndex;
+
+		m_freeTail = slotIndex;
+	}
+
+	template<typename T>
+	void SlotMap<T>::Reallocate(size_t capacity)
+	{
+		iol_assert(capacity >= m_count);
+		iol_assert(capacity <= SLOT_MAP_MAX_CAPACITY);
+
+		// Elements, slot indices and slots share one allocation
+		size_t slotIndicesOffset = core::Align(sizeof(T) * capacity, alignof(uint32));
+		size_t slotsOffset = core::Align(slotIndicesOffset + sizeof(uint32) * capacity, alignof(Slot));
+		size_t size = slotsOffset + sizeof(Slot) * capacity;
+		size_t alignment = core::Max<size_t>(alignof(T), MEMORY_ALIGNMENT_DEFAULT);
+		uint8* pBuffer;
+
+		if (m_pAllocator != nullptr)
+			pBuffer = (uint8*)m_pAllocator->Allocate(size, alignment);
+		else
+			pBuffer = (uint8*)iol_alloc_raw_aligned(size, alignment);
+
+		iol_assert(pBuffer != nullptr);
+
+		T* pElements = (T*)pBuffer;
+		uint32* pSlotIndices = (uint32*)(pBuffer + slotIndicesOffset);
+		Slot* pSlots = (Slot*)(pBuffer + slotsOffset);
+
+		if (m_pElements != nullptr)
+		{
+			for (size_t i = 0; i < m_count; i++)
+			{
+				new (pElements + i) T(std::move(m_pElements[i]));
+				m_pElements[i].~T();
+			}
+
+			if (m_count > 0)
+				memory::Copy(pSlotIndices, sizeof(uint32) * m_count, m_pSlotIndices);
+
+			if (m_numSlots > 0)
+				memory::Copy(pSlots, sizeof(Slot) * m_numSlots, m_pSlots);
+
+			if (m_pAllocator != nullptr)
+				m_pAllocator->Free(m_pElements);
+			else
+				iol_free_aligned(m_pElements);
+		}
+
+		m_pElements = pElements;
+		m_pSlotIndices = pSlotIndices;
+		m_pSlots = pSlots;
+		m_capacity = capacity;
+	}
+}
+
+#endif // IOLITE_SLOT_MAP_INL_H
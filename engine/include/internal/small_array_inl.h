@@ -0,0 +1,303 @@
+#ifndef IOLITE_SMALL_ARRAY_INL_H
+#define IOLITE_SMALL_ARRAY_INL_H
+
+#include "iol_small_array.h"
+#include "iol_array.h"
+#include "iol_core.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace iol
+{
+	template<typename T, size_t N>
+	SmallArray<T, N>::SmallArray()
+	{
+		static_assert(N > 0, "SmallArray needs room for at least one element");
+		static_assert(std::is_trivially_copyable<T>::value, "SmallArray only holds trivially copyable elements");
+
+		pData = (T*)m_inlineStorage;
+		capacity = N;
+		count = 0;
+		pAllocator = nullptr;
+	}
+
+	template<typename T, size_t N>
+	SmallArray<T, N>::SmallArray(size_t _capacity)
+		: SmallArray()
+	{
+		Create(_capacity);
+	}
+
+	template<typename T, size_t N>
+	SmallArray<T, N>::SmallArray(size_t _capacity, Allocator* _pAllocator)
+		: SmallArray()
+	{
+		pAllocator = _pAllocator;
+		Create(_capacity);
+	}
+
+	template<typename T, size_t N>
+	SmallArray<T, N>::~SmallArray()
+	{
+		Destroy();
+	}
+
+	template<typename T, size_t N>
+	SmallArray<T, N>::SmallArray(SmallArray&& other)
+		: SmallArray()
+	{
+		*this = std::move(other);
+	}
+
+	template<typename T, size_t N>
+	SmallArray<T, N>& SmallArray<T, N>::operator=(SmallArray&& other)
+	{
+		if (this == &other)
+			return *this;
+
+		Destroy();
+		pAllocator = other.pAllocator;
+
+		if (other.IsInline())
+		{
+			if (other.count > 0)
+				memory::Copy(pData, sizeof(T) * other.count, other.pData);
+		}
+		else
+		{
+			pData = other.pData;
+			capacity = other.capacity;
+			other.pData = (T*)other.m_inlineStorage;
+		}
+
+		count = other.count;
+		other.capacity = N;
+		other.count = 0;
+
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::Create(size_t _capacity)
+	{
+		count = 0;
+		Reserve(_capacity);
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::Create(size_t _capacity, Allocator* _pAllocator)
+	{
+		if (pAllocator != _pAllocator)
+		{
+			Destroy();
+			pAllocator = _pAllocator;
+		}
+
+		Create(_capacity);
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::Destroy()
+	{
+		if (!IsInline())
+		{
+			FreeStorage(pData);
+			pData = (T*)m_inlineStorage;
+		}
+
+		capacity = N;
+		count = 0;
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::Clear()
+	{
+		count = 0;
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::Reserve(size_t _capacity)
+	{
+		if (_capacity > capacity)
+			Reallocate(_capacity);
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::Resize(size_t _count)
+	{
+		Reserve(_count);
+
+		for (size_t i = count; i < _count; ++i)
+			new (pData + i) T();
+
+		count = _count;
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::ShrinkToFit()
+	{
+		if (!IsInline() && count < capacity)
+			Reallocate(core::Max(count, N));
+	}
+
+	template<typename T, size_t N>
+	T* SmallArray<T, N>::AllocateStorage(size_t _capacity)
+	{
+		if (pAllocator != nullptr)
+			return (T*)pAllocator->Allocate(sizeof(T) * _capacity, alignof(T));
+
+		// The default heap only guarantees MEMORY_ALIGNMENT_DEFAULT
+		if constexpr (alignof(T) > MEMORY_ALIGNMENT_DEFAULT)
+			return iol_alloc_array_aligned(T, _capacity, alignof(T));
+		else
+			return iol_alloc_array(T, _capacity);
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::FreeStorage(T* pStorage)
+	{
+		if (pAllocator != nullptr)
+			pAllocator->Free(pStorage);
+		else if constexpr (alignof(T) > MEMORY_ALIGNMENT_DEFAULT)
+			iol_free_aligned(pStorage);
+		else
+			iol_free(pStorage);
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::Reallocate(size_t _capacity)
+	{
+		iol_assert(_capacity >= count);
+
+		T* pNewData = _capacity <= N ? (T*)m_inlineStorage : AllocateStorage(_capacity);
+		iol_assert(pNewData != nullptr);
+
+		if (pNewData != pData)
+		{
+			if (count > 0)
+				memory::Copy(pNewData, sizeof(T) * count, pData);
+
+			if (!IsInline())
+				FreeStorage(pData);
+		}
+
+		pData = pNewData;
+		capacity = core::Max(_capacity, N);
+	}
+
+	template<typename T, size_t N>
+	T& SmallArray<T, N>::PushBack(const T& element)
+	{
+		if (count == capacity)
+		{
+			// element may live inside the storage that is about to be reallocated
+			T copy = element;
+			Reallocate(core::Max<size_t>(capacity * 2, ARRAY_MIN_GROW_CAPACITY));
+			return PushBack(copy);
+		}
+
+		T& slot = pData[count];
+		slot = element;
+		count++;
+
+		return slot;
+	}
+
+	template<typename T, size_t N>
+	T& SmallArray<T, N>::PushBack()
+	{
+		if (count == capacity)
+			Reallocate(core::Max<size_t>(capacity * 2, ARRAY_MIN_GROW_CAPACITY));
+
+		T& slot = pData[count];
+		count++;
+
+		return slot;
+	}
+
+	template<typename T, size_t N>
+	T* SmallArray<T, N>::PushBackArray(const T* pElements, size_t a_count)
+	{
+		if (count + a_count > capacity)
+		{
+			// pElements may point into the storage that is about to be reallocated
+			bool aliased = (uintptr_t)pElements >= (uintptr_t)pData && (uintptr_t)pElements < (uintptr_t)(pData + count);
+			size_t offset = aliased ? (size_t)(pElements - pData) : 0;
+
+			Reallocate(core::Max(capacity * 2, count + a_count));
+
+			if (aliased)
+				pElements = pData + offset;
+		}
+
+		T* pFirstElement = pData + count;
+
+		if (a_count > 0)
+			memory::Copy(pFirstElement, sizeof(T) * a_count, pElements);
+
+		count += a_count;
+
+		return pFirstElement;
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::PopBack()
+	{
+		iol_assert(count > 0);
+
+		count--;
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::Remove(const T& element)
+	{
+		for (size_t i = count; i-- > 0;)
+		{
+			if (pData[i] == element)
+				RemoveAt(i);
+		}
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::RemoveUnordered(const T& element)
+	{
+		for (size_t i = count; i-- > 0;)
+		{
+			if (pData[i] == element)
+				RemoveAtUnordered(i);
+		}
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::RemoveAt(size_t index)
+	{
+		iol_assert(index < count);
+
+		size_t numElementsBehind = count - index - 1;
+
+		if (numElementsBehind > 0)
+		{
+			memory::Move(pData + index, numElementsBehind * sizeof(T), pData + index + 1);
+		}
+
+		count--;
+	}
+
+	template<typename T, size_t N>
+	void SmallArray<T, N>::RemoveAtUnordered(size_t index)
+	{
+		iol_assert(index < count);
+
+		pData[index] = pData[count - 1];
+		count--;
+	}
+
+	template<typename T, size_t N>
+	bool SmallArray<T, N>::IsFull()
+	{
+		return count == capacity;
+	}
+}
+
+#endif // IOLITE_SMALL_ARRAY_INL_H
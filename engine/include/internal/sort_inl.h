@@ -0,0 +1,361 @@
+#ifndef IOLITE_SORT_INL_H
+#define IOLITE_SORT_INL_H
+
+#include "iol_sort.h"
+#include "iol_memory.h"
+#include "iol_core.h"
+#include "iol_debug.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace iol
+{
+	template<typename TFunction>
+	void sort_parallel_for(uint32 numTasks, TFunction& function)
+	{
+		core::RunTasks(numTasks, [](uint32 taskIndex, void* pUserData) { (*(TFunction*)pUserData)(taskIndex); }, &function);
+	}
+
+	iol_inline void* sort_allocate_temp(size_t size, size_t alignment, Allocator* pAllocator)
+	{
+		alignment = core::Max<size_t>(alignment, MEMORY_ALIGNMENT_DEFAULT);
+		void* pMemory;
+
+		if (pAllocator != nullptr)
+			pMemory = pAllocator->Allocate(size, alignment);
+		else
+			pMemory = iol_alloc_raw_aligned(size, alignment);
+
+		iol_assert(pMemory != nullptr);
+		return pMemory;
+	}
+
+	iol_inline void sort_free_temp(void* pMemory, Allocator* pAllocator)
+	{
+		if (pAllocator != nullptr)
+			pAllocator->Free(pMemory);
+		else
+			iol_free_aligned(pMemory);
+	}
+
+	template<typename T, typename TLess>
+	void sort_insertion(T* pElements, size_t count, TLess& less)
+	{
+		for (size_t i = 1; i < count; i++)
+		{
+			T value = std::move(pElements[i]);
+			size_t j = i;
+
+			for (; j > 0 && less(value, pElements[j - 1]); j--)
+				pElements[j] = std::move(pElements[j - 1]);
+
+			pElements[j] = std::move(value);
+		}
+	}
+
+	template<typename T, typename TLess>
+	void sort_sift_down(T* pElements, size_t root, size_t count, TLess& less)
+	{
+		T value = std::move(pElements[root]);
+
+		for (size_t child = root * 2 + 1; child < count; child = root * 2 + 1)
+		{
+			if (child + 1 < count && less(pElements[child], pElements[child + 1]))
+				child++;
+
+			if (!less(value, pElements[child]))
+				break;
+
+			pElements[root] = std::move(pElements[child]);
+			root = child;
+		}
+
+		pElements[root] = std::move(value);
+	}
+
+	template<typename T, typename TLess>
+	void sort_heap(T* pElements, size_t count, TLess& less)
+	{
+		for (size_t i = count / 2; i-- > 0;)
+			sort_sift_down(pElements, i, count, less);
+
+		for (size_t end = count; end-- > 1;)
+		{
+			std::swap(pElements[0], pElements[end]);
+			sort_sift_down(pElements, 0, end, less);
+		}
+	}
+
+	template<typename T, typename TLess>
+	void sort_intro(T* pElements, size_t count, uint32 depthLimit, TLess& less)
+	{
+		while (count > SORT_INSERTION_THRESHOLD)
+		{
+			if (depthLimit == 0)
+			{
+				sort_heap(pElements, count, less);
+				return;
+			}
+
+			depthLimit--;
+
+			// Median of three, the outer elements also stop the partition scans
+			size_t last = count - 1;
+			size_t mid = count / 2;
+
+			if (less(pElements[mid], pElements[0]))
+				std::swap(pElements[mid], pElements[0]);
+			if (less(pElements[last], pElements[mid]))
+				std::swap(pElements[last], pElements[mid]);
+			if (less(pElements[mid], pElements[0]))
+				std::swap(pElements[mid], pElements[0]);
+
+			// Hoare partition around the middle value, the split is always in [0, last)
+			T pivot = pElements[mid];
+			size_t i = 0;
+			size_t j = last;
+
+			for (;;)
+			{
+				while (less(pElements[i], pivot))
+					i++;
+
+				while (less(pivot, pElements[j]))
+					j--;
+
+				if (i >= j)
+					break;
+
+				std::swap(pElements[i], pElements[j]);
+				i++;
+				j--;
+			}
+
+			size_t leftCount = j + 1;
+
+			// Recurse into the smaller half to bound the stack depth
+			if (leftCount < count - leftCount)
+			{
+				sort_intro(pElements, leftCount, depthLimit, less);
+				pElements += leftCount;
+				count -= leftCount;
+			}
+			else
+			{
+				sort_intro(pElements + leftCount, count - leftCount, depthLimit, less);
+				count = leftCount;
+			}
+		}
+
+		sort_insertion(pElements, count, less);
+	}
+
+	// Number of elements taken from A among the first k elements of the stable merge of A and B
+	template<typename T, typename TLess>
+	size_t sort_merge_path(const T* pA, size_t countA, const T* pB, size_t countB, size_t k, TLess& less)
+	{
+		size_t lo = k > countB ? k - countB : 0;
+		size_t hi = core::Min(k, countA);
+
+		while (lo < hi)
+		{
+			size_t i = (lo + hi) / 2;
+
+			if (less(pB[k - i - 1], pA[i]))
+				hi = i;
+			else
+				lo = i + 1;
+		}
+
+		return lo;
+	}
+
+	template<typename T, typename TLess>
+	void sort_merge(const T* pA, size_t countA, const T* pB, size_t countB, T* pDest, TLess& less)
+	{
+		const T* pEndA = pA + countA;
+		const T* pEndB = pB + countB;
+
+		while (pA != pEndA && pB != pEndB)
+		{
+			if (less(*pB, *pA))
+				*pDest++ = *pB++;
+			else
+				*pDest++ = *pA++;
+		}
+
+		while (pA != pEndA)
+			*pDest++ = *pA++;
+
+		while (pB != pEndB)
+			*pDest++ = *pB++;
+	}
+
+	template<typename T, typename TLess>
+	void sort::Sort(T* pElements, size_t count, TLess less)
+	{
+		if (count < 2)
+			return;
+
+		uint32 depthLimit = 2 * (63 - core::CountLeadingZeros((uint64)count));
+		sort_intro(pElements, count, depthLimit, less);
+	}
+
+	template<typename T, typename TLess>
+	void sort::Sort(Array<T>& array, TLess less)
+	{
+		Sort(array.pData, array.count, less);
+	}
+
+	template<typename T>
+	void sort::Sort(Array<T>& array)
+	{
+		Sort(array.pData, array.count, [](const T& a, const T& b) { return a < b; });
+	}
+
+	template<typename T, typename TGetKey>
+	void sort::RadixSort(T* pElements, size_t count, TGetKey getKey, Allocator* pTempAllocator)
+	{
+		typedef typename std::decay<decltype(getKey(*pElements))>::type TKey;
+
+		static_assert(std::is_integral<TKey>::value && std::is_unsigned<TKey>::value, "RadixSort needs unsigned integer keys");
+		static_assert(std::is_trivially_copyable<T>::value, "RadixSort only sorts trivially copyable elements");
+
+		const uint32 numDigits = sizeof(TKey);
+
+		if (count < 2)
+			return;
+
+		// The histograms of all digits are built in a single pass over the keys
+		size_t histograms[numDigits][256] = {};
+
+		for (size_t i = 0; i < count; i++)
+		{
+			TKey key = getKey(pElements[i]);
+
+			for (uint32 digit = 0; digit < numDigits; digit++)
+				histograms[digit][(key >> (digit * 8)) & 0xFF]++;
+		}
+
+		T* pTemp = (T*)sort_allocate_temp(sizeof(T) * count, alignof(T), pTempAllocator);
+		T* pSrc = pElements;
+		T* pDest = pTemp;
+
+		for (uint32 digit = 0; digit < numDigits; digit++)
+		{
+			size_t* pHistogram = histograms[digit];
+			uint32 shift = digit * 8;
+
+			if (pHistogram[(getKey(pSrc[0]) >> shift) & 0xFF] == count)
+				continue;
+
+			size_t offset = 0;
+
+			for (uint32 i = 0; i < 256; i++)
+			{
+				size_t bucketCount = pHistogram[i];
+				pHistogram[i] = offset;
+				offset += bucketCount;
+			}
+
+			for (size_t i = 0; i < count; i++)
+				pDest[pHistogram[(getKey(pSrc[i]) >> shift) & 0xFF]++] = pSrc[i];
+
+			std::swap(pSrc, pDest);
+		}
+
+		if (pSrc != pElements)
+			memory::Copy(pElements, sizeof(T) * count, pSrc);
+
+		sort_free_temp(pTemp, pTempAllocator);
+	}
+
+	template<typename T, typename TGetKey>
+	void sort::RadixSort(Array<T>& array, TGetKey getKey, Allocator* pTempAllocator)
+	{
+		RadixSort(array.pData, array.count, getKey, pTempAllocator);
+	}
+
+	template<typename T, typename TLess>
+	void sort::ParallelSort(Array<T>& array, TLess less, uint32 numThreads, Allocator* pTempAllocator)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "ParallelSort only sorts trivially copyable elements");
+
+		T* pElements = array.pData;
+		size_t count = array.count;
+
+		if (numThreads == 0)
+			numThreads = core::GetHardwareThreadCount();
+
+		numThreads = core::Min<uint32>(numThreads, CORE_MAX_TASKS);
+
+		// A power of two number of chunks, so every merge round halves the number of runs
+		uint32 numChunks = 1;
+
+		while (numChunks * 2 <= numThreads && count / (numChunks * 2) >= SORT_PARALLEL_MIN_CHUNK)
+			numChunks *= 2;
+
+		if (numChunks == 1)
+		{
+			Sort(pElements, count, less);
+			return;
+		}
+
+		auto getChunkBegin = [count, numChunks](size_t chunk) { return count * chunk / numChunks; };
+
+		auto sortChunk = [&](uint32 chunk)
+		{
+			size_t begin = getChunkBegin(chunk);
+			Sort(pElements + begin, getChunkBegin(chunk + 1) - begin, less);
+		};
+
+		sort_parallel_for(numChunks, sortChunk);
+
+		T* pTemp = (T*)sort_allocate_temp(sizeof(T) * count, alignof(T), pTempAllocator);
+		T* pSrc = pElements;
+		T* pDest = pTemp;
+
+		for (uint32 runChunks = 1; runChunks < numChunks; runChunks *= 2)
+		{
+			// Every pair of runs is merged by 2 * runChunks tasks, each one writes an equal share of the output
+			uint32 tasksPerMerge = runChunks * 2;
+
+			auto mergeRuns = [&](uint32 task)
+			{
+				uint32 firstChunk = (task / tasksPerMerge) * tasksPerMerge;
+				uint32 part = task % tasksPerMerge;
+
+				size_t beginA = getChunkBegin(firstChunk);
+				size_t beginB = getChunkBegin(firstChunk + runChunks);
+				size_t end = getChunkBegin(firstChunk + tasksPerMerge);
+				size_t countA = beginB - beginA;
+				size_t countB = end - beginB;
+				size_t total = countA + countB;
+
+				size_t k0 = total * part / tasksPerMerge;
+				size_t k1 = total * (part + 1) / tasksPerMerge;
+				size_t i0 = sort_merge_path(pSrc + beginA, countA, pSrc + beginB, countB, k0, less);
+				size_t i1 = sort_merge_path(pSrc + beginA, countA, pSrc + beginB, countB, k1, less);
+
+				sort_merge(pSrc + beginA + i0, i1 - i0, pSrc + beginB + (k0 - i0), (k1 - i1) - (k0 - i0), pDest + beginA + k0, less);
+			};
+
+			sort_parallel_for(numChunks, mergeRuns);
+			std::swap(pSrc, pDest);
+		}
+
+		if (pSrc != pElements)
+			memory::Copy(pElements, sizeof(T) * count, pSrc);
+
+		sort_free_temp(pTemp, pTempAllocator);
+	}
+
+	template<typename T>
+	void sort::ParallelSort(Array<T>& array)
+	{
+		ParallelSort(array, [](const T& a, const T& b) { return a < b; });
+	}
+}
+
+#endif // IOLITE_SORT_INL_H
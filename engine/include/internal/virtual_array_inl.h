@@ -0,0 +1,205 @@
+#ifndef IOLITE_VIRTUAL_ARRAY_INL_H
+#define IOLITE_VIRTUAL_ARRAY_INL_H
+
+#include "iol_virtual_array.h"
+#include "iol_core.h"
+
+namespace iol
+{
+	template<typename T>
+	VirtualArray<T>::VirtualArray()
+	{
+		pData = nullptr;
+		capacity = 0;
+		count = 0;
+		maxCapacity = 0;
+		flags = VirtualArrayFlags_None;
+		m_reservedSize = 0;
+		m_committedSize = 0;
+	}
+
+	template<typename T>
+	VirtualArray<T>::VirtualArray(size_t _maxCapacity, uint32 _flags)
+	{
+		pData = nullptr;
+		capacity = 0;
+		count = 0;
+		maxCapacity = 0;
+		flags = VirtualArrayFlags_None;
+		m_reservedSize = 0;
+		m_committedSize = 0;
+		Create(_maxCapacity, _flags);
+	}
+
+	template<typename T>
+	VirtualArray<T>::~VirtualArray()
+	{
+		Destroy();
+	}
+
+	template<typename T>
+	bool VirtualArray<T>::Create(size_t _maxCapacity, uint32 _flags)
+	{
+		iol_assert(pData == nullptr);
+		iol_assert(_maxCapacity > 0);
+
+		flags = _flags;
+		m_reservedSize = core::Align(sizeof(T) * _maxCapacity, GetCommitGranularity());
+		pData = (T*)memory::ReserveVirtual(m_reservedSize);
+
+		if (pData == nullptr)
+		{
+			m_reservedSize = 0;
+			return false;
+		}
+
+		if (flags & VirtualArrayFlags_HugePages)
+			memory::AdviseHugePages(pData, m_reservedSize);
+
+		maxCapacity = _maxCapacity;
+		capacity = 0;
+		count = 0;
+		m_committedSize = 0;
+
+		return true;
+	}
+
+	template<typename T>
+	void VirtualArray<T>::Destroy()
+	{
+		if (pData != nullptr)
+		{
+			memory::ReleaseVirtual(pData, m_reservedSize);
+			pData = nullptr;
+		}
+
+		capacity = 0;
+		count = 0;
+		maxCapacity = 0;
+		m_reservedSize = 0;
+		m_committedSize = 0;
+	}
+
+	template<typename T>
+	void VirtualArray<T>::Clear()
+	{
+		count = 0;
+	}
+
+	template<typename T>
+	void VirtualArray<T>::Reserve(size_t _capacity)
+	{
+		if (_capacity > capacity)
+			Commit(_capacity);
+	}
+
+	template<typename T>
+	void VirtualArray<T>::Resize(size_t _count)
+	{
+		Reserve(_count);
+
+		for (size_t i = count; i < _count; ++i)
+			new (pData + i) T();
+
+		count = _count;
+	}
+
+	template<typename T>
+	void VirtualArray<T>::ShrinkToFit()
+	{
+		size_t usedSize = core::Align(sizeof(T) * count, GetCommitGranularity());
+
+		if (usedSize < m_committedSize)
+		{
+			memory::DecommitVirtual((uint8*)pData + usedSize, m_committedSize - usedSize);
+			m_committedSize = usedSize;
+			capacity = core::Min(m_committedSize / sizeof(T), maxCapacity);
+		}
+	}
+
+	template<typename T>
+	T& VirtualArray<T>::PushBack()
+	{
+		if (count == capacity)
+			Commit(count + 1);
+
+		iol_assert(count < capacity);
+
+		T& slot = *(pData + count);
+		count++;
+
+		return slot;
+	}
+
+	template<typename T>
+	T& VirtualArray<T>::PushBack(const T& element)
+	{
+		T& slot = PushBack();
+		slot = element;
+
+		return slot;
+	}
+
+	template<typename T>
+	T* VirtualArray<T>::PushBackArray(const T* pElements, size_t a_count)
+	{
+		if (count + a_count > capacity)
+			Commit(count + a_count);
+
+		iol_assert(count + a_count <= capacity);
+
+		T* pFirstElement = pData + count;
+
+		for (size_t i = 0; i < a_count; ++i)
+		{
+			pFirstElement[i] = pElements[i];
+		}
+
+		count += a_count;
+
+		return pFirstElement;
+	}
+
+	template<typename T>
+	void VirtualArray<T>::PopBack()
+	{
+		iol_assert(count > 0);
+
+		count--;
+	}
+
+	template<typename T>
+	size_t VirtualArray<T>::GetCommitGranularity() const
+	{
+		if (flags & VirtualArrayFlags_HugePages)
+			return core::Max<size_t>(MEMORY_HUGE_PAGE_SIZE, memory::GetPageSize());
+
+		return memory::GetPageSize();
+	}
+
+	template<typename T>
+	void VirtualArray<T>::Commit(size_t _capacity)
+	{
+		iol_assert(pData != nullptr);
+
+		if (_capacity > maxCapacity)
+		{
+			iol_log_error("VirtualArray out of reserved memory! requested: %zu | maxCapacity: %zu", _capacity, maxCapacity);
+			iol_assert(false);
+			return;
+		}
+
+		// Commit geometrically to keep the number of system calls low
+		size_t requiredSize = sizeof(T) * _capacity;
+		size_t newCommittedSize = core::Max<size_t>(requiredSize, core::Max<size_t>(m_committedSize * 2, VIRTUAL_ARRAY_MIN_COMMIT_SIZE));
+		newCommittedSize = core::Min(core::Align(newCommittedSize, GetCommitGranularity()), m_reservedSize);
+
+		if (!memory::CommitVirtual((uint8*)pData + m_committedSize, newCommittedSize - m_committedSize))
+			return;
+
+		m_committedSize = newCommittedSize;
+		capacity = core::Min(m_committedSize / sizeof(T), maxCapacity);
+	}
+}
+
+#endif // IOLITE_VIRTUAL_ARRAY_INL_H
@@ -5,18 +5,35 @@
 #include "iol_debug.h"
 #include "iol_memory.h"
 
+#define ARRAY_MIN_GROW_CAPACITY 16
+
 namespace iol
 {
+	enum ArrayFlags
+	{
+		ArrayFlags_None = 0,
+		ArrayFlags_Growable = iol_bit(0), // PushBack grows the capacity instead of asserting when the array is full
+		ArrayFlags_View = iol_bit(1) // pData is borrowed memory, e.g. a file mapping, it is never freed or reallocated
+	};
+
 	template<typename T>
 	struct Array
 	{
 		Array();
 		Array(size_t _capacity);
+		Array(size_t _capacity, Allocator* _pAllocator);
 		~Array();
 
 		void     Create(size_t _capacity);
+		void     Create(size_t _capacity, Allocator* _pAllocator);
+		void     CreateAligned(size_t _capacity, size_t _alignment);
+		void     CreateGrowable(size_t _capacity);
+		void     CreateView(T* pElements, size_t _count); // the elements have to outlive the array
 		void     Destroy();
 		void     Clear();
+		void     Reserve(size_t _capacity);
+		void     Resize(size_t _count);
+		void     ShrinkToFit();
 		T&       PushBack();
 		T&       PushBack(const T& element);
 		T*       PushBackArray(const T* pElements, size_t count);
@@ -26,6 +43,8 @@ namespace iol
 		void     RemoveAt(size_t index);
 		void     RemoveAtUnordered(size_t index);
 		bool     IsFull();
+		bool     IsGrowable() const { return (flags & ArrayFlags_Growable) != 0; }
+		bool     IsView() const { return (flags & ArrayFlags_View) != 0; }
 
 		T&       operator[] (size_t index) { iol_assert(index < count); return pData[index]; }
 		const T& operator[] (size_t index) const { iol_assert(index < count); return pData[index]; }
@@ -33,6 +52,15 @@ namespace iol
 		T* pData;
 		size_t capacity;
 		size_t count;
+		Allocator* pAllocator; // if set, storage is taken from this allocator instead of the default heap
+		size_t alignment; // alignment of pData if > 0, otherwise MEMORY_ALIGNMENT_DEFAULT
+		uint32 flags; // see enum ArrayFlags
+
+	private:
+		T*       AllocateStorage(size_t _capacity);
+		void     FreeStorage(T* pStorage);
+		void     Reallocate(size_t _capacity);
+		void     Grow(size_t minCapacity);
 	};
 }
 
@@ -0,0 +1,136 @@
+#ifndef IOLITE_BINARY_STREAM_H
+#define IOLITE_BINARY_STREAM_H
+
+#include "iol_definitions.h"
+#include "iol_file.h"
+
+#define BINARY_STREAM_DEFAULT_BUFFER_SIZE (1024 * 1024)
+#define BINARY_STREAM_MAX_VARINT_SIZE     10
+
+// The stream format is little endian, values are only swapped on big endian hosts
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define BINARY_STREAM_SWAP_BYTES 1
+#else
+#define BINARY_STREAM_SWAP_BYTES 0
+#endif
+
+namespace iol
+{
+	enum class BinaryStreamMode
+	{
+		None,
+		File,
+		Memory,
+		GrowableMemory,
+	};
+
+	/*
+	* Buffered writer for little endian binary data.
+	* Small writes are collected in the buffer, spans at least as large as the buffer go straight to the file,
+	* so serializing large arrays costs a few big file::Write calls.
+	* Errors are sticky: after the first failed write every later write fails too, check HasError() or the result of Destroy() once at the end.
+	*/
+	class BinaryWriter
+	{
+	public:
+		BinaryWriter();
+		~BinaryWriter();
+
+		BinaryWriter(const BinaryWriter& other) = delete;
+		BinaryWriter& operator=(const BinaryWriter& other) = delete;
+
+		void     Create(File* pFile, size_t bufferSize = BINARY_STREAM_DEFAULT_BUFFER_SIZE); // the file stays open after Destroy
+		void     Create(void* pMemory, size_t capacity); // writing past 'capacity' is an error
+		void     CreateGrowable(size_t initialCapacity);
+		bool     Destroy(); // flushes the buffer, false if any write failed
+
+		bool     Flush();
+
+		bool     WriteBytes(const void* pData, size_t size);
+		bool     WriteVarUint(uint64 value); // LEB128, 1 byte for values below 128
+		bool     WriteVarInt(int64 value); // zigzag encoded, small negative values stay small
+		bool     WriteString(const char* pString); // varint length followed by the characters, no terminator
+
+		/*
+		* Arithmetic and enum values are stored little endian.
+		* Other trivially copyable types are stored with their memory layout, they must not contain pointers or padding that matters.
+		*/
+		template<typename T> bool Write(const T& value);
+		template<typename T> bool WriteArray(const T* pElements, size_t count);
+
+		size_t   GetPosition() const { return m_flushedSize + m_offset; } // number of bytes written so far
+		bool     HasError() const { return m_error; }
+
+		// Memory modes only
+		const uint8* GetData() const { return m_pBuffer; }
+		size_t   GetSize() const { return m_offset; }
+
+	private:
+		bool     WriteBytesSlow(const void* pData, size_t size);
+
+		BinaryStreamMode m_mode;
+		File* m_pFile;
+		uint8* m_pBuffer;
+		size_t m_capacity;
+		size_t m_offset;
+		size_t m_flushedSize;
+		bool m_ownsBuffer;
+		bool m_error;
+	};
+
+	/*
+	* Buffered reader for data written by BinaryWriter, either from a file or from a memory view such as a FileMapping.
+	* Errors are sticky like in BinaryWriter, failed reads return false and zero the output.
+	*/
+	class BinaryReader
+	{
+	public:
+		BinaryReader();
+		~BinaryReader();
+
+		BinaryReader(const BinaryReader& other) = delete;
+		BinaryReader& operator=(const BinaryReader& other) = delete;
+
+		void     Create(File* pFile, size_t bufferSize = BINARY_STREAM_DEFAULT_BUFFER_SIZE); // reads from the current file position
+		void     Create(const void* pData, size_t size); // no copy, the data has to outlive the reader
+		void     Destroy();
+
+		bool     ReadBytes(void* pOutData, size_t size);
+		bool     ReadVarUint(uint64* pOutValue);
+		bool     ReadVarInt(int64* pOutValue);
+		bool     ReadString(char* pOutString, size_t capacity); // fails if the string and its terminator don't fit
+		bool     Skip(size_t size);
+
+		/*
+		* Returns a pointer to the next 'size' bytes and skips them, nullptr on failure.
+		* Only available for memory views, lets callers use large arrays in place instead of copying them.
+		*/
+		const void* ReadSpan(size_t size);
+
+		template<typename T> bool Read(T* pOutValue);
+		template<typename T> bool ReadArray(T* pOutElements, size_t count);
+
+		size_t   GetPosition() const { return m_bufferPosition + m_offset; }
+		bool     IsAtEnd(); // false while the file has data left, fills the buffer to find out
+		bool     HasError() const { return m_error; }
+
+	private:
+		bool     ReadBytesSlow(void* pOutData, size_t size);
+		bool     Refill();
+
+		BinaryStreamMode m_mode;
+		File* m_pFile;
+		const uint8* m_pBuffer;
+		uint8* m_pOwnedBuffer;
+		size_t m_capacity;
+		size_t m_size; // valid bytes in the buffer
+		size_t m_offset;
+		size_t m_bufferPosition; // stream position of the first buffer byte
+		size_t m_fileStartPosition;
+		bool m_error;
+	};
+}
+
+#include "internal/binary_stream_inl.h"
+
+#endif // IOLITE_BINARY_STREAM_H
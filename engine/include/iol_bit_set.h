@@ -0,0 +1,62 @@
+#ifndef IOLITE_BIT_SET_H
+#define IOLITE_BIT_SET_H
+
+#include "iol_definitions.h"
+#include "iol_debug.h"
+#include "iol_memory.h"
+
+#define BIT_SET_WORD_BITS 64
+#define BIT_SET_INVALID_INDEX ((size_t)-1)
+
+namespace iol
+{
+	/*
+	* Dynamically sized set of bits stored in 64 bit words.
+	* Range operations work on whole words, counting and combining sets use SSE2/NEON.
+	* Visit the set bits with: for (size_t i = bits.FindNextSet(0); i != BIT_SET_INVALID_INDEX; i = bits.FindNextSet(i + 1))
+	*/
+	struct BitSet
+	{
+		BitSet();
+		BitSet(size_t _numBits, Allocator* _pAllocator = nullptr);
+		~BitSet();
+
+		BitSet(const BitSet& other) = delete;
+		BitSet& operator=(const BitSet& other) = delete;
+
+		void     Create(size_t _numBits, Allocator* _pAllocator = nullptr);
+		void     Destroy();
+		void     Resize(size_t _numBits);
+
+		void     Set(size_t index) { iol_assert(index < numBits); pWords[index / BIT_SET_WORD_BITS] |= GetMask(index); }
+		void     Clear(size_t index) { iol_assert(index < numBits); pWords[index / BIT_SET_WORD_BITS] &= ~GetMask(index); }
+		bool     Test(size_t index) const { iol_assert(index < numBits); return (pWords[index / BIT_SET_WORD_BITS] & GetMask(index)) != 0; }
+		void     Assign(size_t index, bool value) { if (value) Set(index); else Clear(index); }
+
+		void     SetRange(size_t first, size_t count);
+		void     ClearRange(size_t first, size_t count);
+		void     SetAll() { SetRange(0, numBits); }
+		void     ClearAll() { ClearRange(0, numBits); }
+
+		size_t   Count() const;
+		bool     Any() const;
+		size_t   FindNextSet(size_t index) const; // first set bit at or after index, BIT_SET_INVALID_INDEX if there is none
+		size_t   FindNextClear(size_t index) const;
+
+		// The other set must have the same size
+		void     Or(const BitSet& other);
+		void     And(const BitSet& other);
+		void     AndNot(const BitSet& other);
+
+		uint64* pWords; // bits past numBits in the last word are always 0
+		size_t numBits;
+		size_t numWords;
+		Allocator* pAllocator; // if set, the words are taken from this allocator instead of the default heap
+
+	private:
+		static uint64 GetMask(size_t index) { return 1ull << (index % BIT_SET_WORD_BITS); }
+		void     ClearUnusedBits();
+	};
+}
+
+#endif // IOLITE_BIT_SET_H
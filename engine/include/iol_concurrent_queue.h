@@ -0,0 +1,95 @@
+#ifndef IOLITE_CONCURRENT_QUEUE_H
+#define IOLITE_CONCURRENT_QUEUE_H
+
+#include "iol_definitions.h"
+#include "iol_memory.h"
+
+#include <atomic>
+
+#define CONCURRENT_QUEUE_MIN_CAPACITY 2
+
+namespace iol
+{
+	/*
+	* Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+	* The capacity is rounded up to a power of two. Producer and consumer indices live on separate cache lines
+	* and each side caches the last seen index of the other side, so it only touches the shared line when the queue looks full or empty.
+	* Elements are copied in and out, so they have to be trivially copyable.
+	*/
+	template<typename T>
+	class SpscQueue
+	{
+	public:
+		SpscQueue();
+		~SpscQueue();
+
+		SpscQueue(const SpscQueue& other) = delete;
+		SpscQueue& operator=(const SpscQueue& other) = delete;
+
+		void     Create(size_t capacity, Allocator* pAllocator = nullptr);
+		void     Destroy();
+
+		bool     TryPush(const T& element); // producer thread only, false if the queue is full
+		bool     TryPop(T* pElement); // consumer thread only, false if the queue is empty
+
+		size_t   GetCount() const; // only a snapshot while the other thread is active
+		size_t   GetCapacity() const { return m_capacity; }
+
+	private:
+		T* m_pElements;
+		size_t m_capacity;
+		size_t m_mask;
+		Allocator* m_pAllocator;
+
+		alignas(MEMORY_CACHE_LINE_SIZE) std::atomic<size_t> m_tail; // written by the producer
+		size_t m_cachedHead;
+
+		alignas(MEMORY_CACHE_LINE_SIZE) std::atomic<size_t> m_head; // written by the consumer
+		size_t m_cachedTail;
+	};
+
+	/*
+	* Bounded lock-free queue for any number of producer and consumer threads (Dmitry Vyukov's bounded MPMC queue).
+	* Every cell has a sequence number that tells producers and consumers whose turn it is,
+	* so a push or pop costs one compare-exchange on the shared position plus a release store on the cell.
+	* The capacity is rounded up to a power of two and elements have to be trivially copyable.
+	*/
+	template<typename T>
+	class MpmcQueue
+	{
+	public:
+		MpmcQueue();
+		~MpmcQueue();
+
+		MpmcQueue(const MpmcQueue& other) = delete;
+		MpmcQueue& operator=(const MpmcQueue& other) = delete;
+
+		void     Create(size_t capacity, Allocator* pAllocator = nullptr);
+		void     Destroy();
+
+		bool     TryPush(const T& element); // false if the queue is full
+		bool     TryPop(T* pElement); // false if the queue is empty
+
+		size_t   GetCount() const; // only a snapshot while other threads are active
+		size_t   GetCapacity() const { return m_capacity; }
+
+	private:
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			T element;
+		};
+
+		Cell* m_pCells;
+		size_t m_capacity;
+		size_t m_mask;
+		Allocator* m_pAllocator;
+
+		alignas(MEMORY_CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePos;
+		alignas(MEMORY_CACHE_LINE_SIZE) std::atomic<size_t> m_dequeuePos;
+	};
+}
+
+#include "internal/concurrent_queue_inl.h"
+
+#endif // IOLITE_CONCURRENT_QUEUE_H
@@ -3,26 +3,37 @@
 
 #include "iol_definitions.h"
 
+#define CORE_MAX_TASKS 64 // upper bound for the number of tasks passed to core::RunTasks
+
 namespace iol
 {
 	template<typename T>
 	struct Array;
 
+	template<typename T, size_t N>
+	struct SmallArray;
+
 	class Mesh;
 
 	namespace core
 	{
 		size_t                     Align(size_t value, size_t alignment);
 		bool                       IsPowerOfTwo(size_t value);
+		size_t                     NextPowerOfTwo(size_t value);
+		uint32                     CountTrailingZeros(uint64 value);
+		uint32                     CountLeadingZeros(uint64 value);
+		uint32                     PopCount(uint64 value);
 		template<typename T> T     Min(T a, T b);
 		template<typename T> T     Max(T a, T b);
 		template<typename T> T     Clamp(T value, T min, T max);
 		template<typename T> T     Remap(T value, T min, T max, T newMin, T newMax);
 		template<typename T> void  Swap(T* pElement0, T* pElement1);
 		double                     GetCurrentTimeSeconds();
+		uint32                     GetHardwareThreadCount(); // at least 1
+		void                       RunTasks(uint32 numTasks, void(*function)(uint32 taskIndex, void* pUserData), void* pUserData); // one thread per task, the calling thread takes task 0 and waits for the others
 		glm::vec3                  CreateDirection(float pitch, float yaw);
 		bool                       RayIntersectsTriangle(glm::vec3 rayOrigin, glm::vec3 rayDir, glm::vec3 v0, glm::vec3 v1, glm::vec3 v2, float& t, glm::vec3& hitPoint);
-		bool                       RayIntersectsMesh(glm::vec3 rayOrigin, glm::vec3 rayDir, const Mesh& mesh, float& t, glm::vec3& hitPoint, Array<uint32>& hitTriangleIndices);
+		bool                       RayIntersectsMesh(glm::vec3 rayOrigin, glm::vec3 rayDir, const Mesh& mesh, float& t, glm::vec3& hitPoint, SmallArray<uint32, 3>& hitTriangleIndices);
 		void                       ScreenPointToRay(glm::vec3 cameraPos, const glm::mat4x4& cameraViewProj, glm::vec2 screenPoint, float screenWidth, float screenHeight, glm::vec3& rayOrigin, glm::vec3& rayDir);
 	}
 }
@@ -25,6 +25,13 @@
 #define iol_countof(arr) sizeof(arr) / sizeof(arr[0])
 #define iol_use(x) (void)x
 
+// SIMD instruction sets that every target of the platform supports, wider sets are detected at runtime
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IOL_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define IOL_SIMD_NEON
+#endif
+
 typedef int8_t int8;
 typedef int16_t int16;
 typedef int32_t int32;
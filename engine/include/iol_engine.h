@@ -15,6 +15,11 @@ namespace iol
 		uint32 windowWidth;
 		uint32 windowHeight;
 		uint32 fixedUPS;
+		size_t frameAllocatorCapacity = 16 * 1024 * 1024; // size of the per-frame scratch memory, see memory::GetFrameAllocator
+		uint32 numFileIoThreads = 2; // worker threads serving file::ReadAsync and file::WriteAsync
+		const char* assetArchivePath = nullptr; // packed assets, mounted at 'assetMountPoint' if the file exists
+		const char* assetDirectoryPath = nullptr; // loose assets, only mounted if there is no archive
+		const char* assetMountPoint = nullptr;
 		bool fullScreen;
 		bool vsync;
 		bool quitOnEscape;
@@ -4,6 +4,7 @@
 #include "iol_definitions.h"
 #include "iol_debug.h"
 #include "iol_input_definitions.h"
+#include "iol_file.h"
 
 namespace iol
 {
@@ -79,6 +80,16 @@ namespace iol
 		int32 dx, dy;
 	};
 
+	struct Event_FileIoCompleted
+	{
+		FileIoRequestId requestId;
+		FileIoOperation operation;
+		FileIoStatus status;
+		void* pData;     // read: the file contents, owned by the requester now. write: the data passed to WriteAsync
+		size_t size;     // number of bytes read or written
+		void* pUserData;
+	};
+
 	enum EventType
 	{
 		EventType_None = -1,
@@ -99,6 +110,8 @@ namespace iol
 		EventType_MouseMoved,
 		EventType_MouseScrolled,
 
+		EventType_FileIoCompleted,
+
 		EventType_Count
 	};
 
@@ -118,6 +131,7 @@ namespace iol
 		Event_MouseButtonReleased mouseButtonReleased;
 		Event_MouseMoved mouseMoved;
 		Event_MouseScrolled mouseScrolled;
+		Event_FileIoCompleted fileIoCompleted;
 	};
 }
 
@@ -19,8 +19,55 @@ namespace iol
 		End,
 	};
 
+	enum FileMapFlags
+	{
+		FileMapFlags_None = 0,
+		FileMapFlags_Sequential = iol_bit(0), // the mapping is read front to back, the OS can read further ahead
+		FileMapFlags_WillNeed = iol_bit(1)    // start reading the whole file into the page cache right away
+	};
+
+	enum class FileIoOperation
+	{
+		Read,
+		Write,
+	};
+
+	enum class FileIoStatus
+	{
+		Completed,
+		Failed,
+		Cancelled,
+	};
+
+	enum class FileIoPriority
+	{
+		Low,
+		Normal,
+		High,
+	};
+
+	typedef uint32 FileIoRequestId; // 0 is never a valid request
+
+	struct FileIoParam
+	{
+		uint32 numThreads = 2;
+		size_t completionQueueCapacity = 256;
+		size_t maxCompletionEventsPerUpdate = 64; // keeps a burst of completions from overflowing the event buffer
+	};
+
 	struct File;
 
+	/*
+	* Read-only view of a whole file, the pages come straight from the OS page cache without a heap copy.
+	* The data is not null terminated, readers have to stay within 'size'.
+	*/
+	struct FileMapping
+	{
+		const uint8* pData;
+		size_t size;
+		void* pHandle; // file mapping object on Windows, unused on Linux
+	};
+
 	namespace file
 	{
 		File*   Open(const char* filePath, FileMode mode);
@@ -31,6 +78,7 @@ namespace iol
 		bool    SetPosition(File* file, size_t position);
 		bool    SetPositionSpecial(File* file, SpecialFilePosition position);
 		size_t  GetPosition(const File* file);
+		bool    Exists(const char* path); // true for files and directories, never logs an error
 
 		/*
 		* Returns a newly allocated buffer with read file size bytes.
@@ -48,6 +96,27 @@ namespace iol
 		*/
 		char*   ReadAllText(const char* filePath, size_t* outFileSize, size_t extraBufferSize);
 
+		/*
+		* Maps the whole file read-only, 'flags' is a combination of FileMapFlags access hints.
+		* Returns false if the file can't be opened or is empty. Call Unmap when you're done!
+		*/
+		bool    Map(const char* filePath, FileMapping* pOutMapping, uint32 flags = FileMapFlags_Sequential | FileMapFlags_WillNeed);
+		void    Unmap(FileMapping* pMapping);
+
+		/*
+		* Asynchronous file access, served by a pool of worker threads.
+		* Pending requests are processed by priority, in submission order within the same priority.
+		* Every request ends with exactly one EventType_FileIoCompleted event, sent by UpdateIoSystem on the main thread.
+		* A read delivers a newly allocated buffer with the file size + 1 byte for the termination character,
+		* the requester owns it and has to free it with iol_free. The data passed to WriteAsync has to stay valid until the event.
+		*/
+		void             CreateIoSystem(const FileIoParam& param);
+		void             DestroyIoSystem();
+		void             UpdateIoSystem();
+		FileIoRequestId  ReadAsync(const char* filePath, FileIoPriority priority = FileIoPriority::Normal, void* pUserData = nullptr);
+		FileIoRequestId  WriteAsync(const char* filePath, const void* pData, size_t size, FileIoPriority priority = FileIoPriority::Normal, void* pUserData = nullptr);
+		bool             CancelAsync(FileIoRequestId requestId); // main thread only, requests that have already started can't be cancelled
+
 		bool    GetDirectoryPath(const char* filePath, char* outDirectoryPath, size_t directoryPathCapacity);
 	}
 }
@@ -0,0 +1,87 @@
+#ifndef IOL_FLAT_HASHMAP_H
+#define IOL_FLAT_HASHMAP_H
+
+#include "iol_definitions.h"
+#include "iol_memory.h"
+#include "iol_hash.h"
+
+#define FLAT_HASHMAP_GROUP_WIDTH 16
+#define FLAT_HASHMAP_MIN_CAPACITY FLAT_HASHMAP_GROUP_WIDTH
+
+namespace iol
+{
+	/*
+	* Open addressing hashmap in the style of SwissTable.
+	* Every slot has a control byte that is either empty, deleted or holds 7 bits of the hash of the key in the slot.
+	* Lookups compare the control bytes of 16 slots at once (SSE2/NEON) and only touch slots whose hash bits match.
+	* The table grows when it is 7/8 full. Adding or removing elements invalidates pointers returned by Get() and iterators.
+	*/
+	template<typename TKey, typename TValue>
+	class FlatHashmap
+	{
+	public:
+		struct Slot
+		{
+			TKey key;
+			TValue value;
+		};
+
+		class Iterator
+		{
+		public:
+			bool     Increment();
+			bool     IsValid() const;
+			TKey&    GetKey() const;
+			TValue&  GetValue() const;
+
+			size_t index;
+			const int8* pControl;
+			Slot* pSlots;
+			size_t capacity;
+		};
+
+	public:
+		FlatHashmap();
+		~FlatHashmap();
+
+		FlatHashmap(const FlatHashmap& other) = delete;
+		FlatHashmap& operator=(const FlatHashmap& other) = delete;
+		FlatHashmap(FlatHashmap&& other) = delete;
+		FlatHashmap& operator=(FlatHashmap&& other) = delete;
+
+		void      Create(size_t capacity, Allocator* pAllocator = nullptr);
+		void      Create(uint32(*hashFunction)(const TKey& key), size_t capacity, Allocator* pAllocator = nullptr);
+		void      Destroy();
+		void      Clear();
+		void      Reserve(size_t count);
+
+		void      Add(const TKey& key, const TValue& value);
+		bool      Remove(const TKey& key);
+		TValue*   Get(const TKey& key) const;
+
+		size_t    GetCount() const { return m_count; }
+		size_t    GetCapacity() const { return m_capacity; }
+		Iterator  GetIterator() const;
+
+	private:
+		uint64    HashKey(const TKey& key) const;
+		size_t    Find(const TKey& key, uint64 hash) const;
+		size_t    FindInsertSlot(uint64 hash) const;
+		void      SetControl(size_t index, int8 control);
+		void      Rehash(size_t newCapacity);
+		void      AllocateTable(size_t capacity);
+		void      FreeTable(int8* pControl);
+
+		uint32(*m_hashFunction)(const TKey& key);
+		Allocator* m_pAllocator;
+		int8* m_pControl; // m_capacity + FLAT_HASHMAP_GROUP_WIDTH bytes, the first group is mirrored at the end
+		Slot* m_pSlots;
+		size_t m_capacity;
+		size_t m_count;
+		size_t m_growthLeft; // number of elements that can be added before the table has to be rehashed
+	};
+}
+
+#include "internal/flat_hashmap_inl.h"
+
+#endif // IOL_FLAT_HASHMAP_H
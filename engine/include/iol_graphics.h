@@ -3,6 +3,7 @@
 
 #include "iol_definitions.h"
 #include "iol_memory.h"
+#include "iol_slot_map.h"
 
 namespace iol
 {
@@ -24,6 +25,17 @@ namespace iol
 	struct VertexArray;
 	struct Texture;
 
+	// Resources are referenced by generational handles, a handle to a destroyed resource is detected instead of dangling
+	typedef Handle<VertexLayout> VertexLayoutHandle;
+	typedef Handle<VertexBuffer> VertexBufferHandle;
+	typedef Handle<IndexBuffer> IndexBufferHandle;
+	typedef Handle<UniformBuffer> UniformBufferHandle;
+	typedef Handle<Shader> ShaderHandle;
+	typedef Handle<RenderTarget> RenderTargetHandle;
+	typedef Handle<GraphicsPipelineState> GraphicsPipelineStateHandle;
+	typedef Handle<VertexArray> VertexArrayHandle;
+	typedef Handle<Texture> TextureHandle;
+
 	enum class PrimitiveType
 	{
 		Point,
@@ -202,9 +214,9 @@ namespace iol
 
 	struct GraphicsPipeLineStateParam
 	{
-		Shader* pShader = nullptr;
-		VertexLayout* pVertexLayout = nullptr;
-		RenderTarget* pRenderTargets = nullptr;
+		ShaderHandle shader = {};
+		VertexLayoutHandle vertexLayout = {};
+		const RenderTargetHandle* pRenderTargets = nullptr;
 		size_t numRenderTargets = 0;
 		PrimitiveType primitiveType = PrimitiveType::TriangleList;
 		BlendMode blendMode = BlendMode::None;
@@ -235,48 +247,48 @@ namespace iol
 		uint32                   GetScreenHeight();
 		float                    GetScreenAspectRatio();
 
-		GraphicsPipelineState*   CreatePipelineState(const GraphicsPipeLineStateParam& param);
-		void                     DestroyPipelineState(GraphicsPipelineState* pPipelineState);
+		GraphicsPipelineStateHandle CreatePipelineState(const GraphicsPipeLineStateParam& param);
+		void                     DestroyPipelineState(GraphicsPipelineStateHandle pipelineState);
 
-		void                     BeginRender(const GraphicsPipelineState* pPipelineState);
+		void                     BeginRender(GraphicsPipelineStateHandle pipelineState);
 		void                     EndRender();
 		void                     Clear(const glm::vec4& color, ClearFlags clearFlags);
 		void                     Draw(size_t startVertexIndex, size_t numVertices);
 		void                     DrawIndexed(size_t numIndices);
 		void                     DrawInstanced(size_t startVertexIndex, size_t numVertices, size_t numInstances);
 		void                     DrawIndexedInstanced(size_t numIndices, size_t numInstances);
-		void                     BindVertexArray(const VertexArray* pVertexArray);
-		void                     BindUniformBuffer(const UniformBuffer** pBuffers, size_t numBuffers);
-		void                     BindTexture(size_t startSlot, const Texture** pTextures, size_t numTextures);
+		void                     BindVertexArray(VertexArrayHandle vertexArray);
+		void                     BindUniformBuffer(const UniformBufferHandle* pBuffers, size_t numBuffers);
+		void                     BindTexture(size_t startSlot, const TextureHandle* pTextures, size_t numTextures);
 		void                     SetViewport(const ViewportData& data);
 		void                     SetViewportFullscreen();
-		void                     SetPipelineState(const GraphicsPipelineState* pPipelineState);
+		void                     SetPipelineState(GraphicsPipelineStateHandle pipelineState);
 
-		Shader*                  CreateShader(const char* pSourceCode);
-		Shader*                  CreateShaderFromFile(const char* pFilePath);
-		void                     DestroyShader(Shader* pShader);
+		ShaderHandle             CreateShader(const char* pSourceCode);
+		ShaderHandle             CreateShaderFromFile(const char* pFilePath);
+		void                     DestroyShader(ShaderHandle shader);
 
 		/* The input-layout object can be reused with any other shader that has an identical input signature. */
-		VertexLayout*            CreateVertexLayout(const Shader* pShader, const VertexAttributeParam* pVertexAttributeParams, size_t numVertexAttributes);
-		void                     DestroyVertexLayout(VertexLayout* pVertexLayout);
+		VertexLayoutHandle       CreateVertexLayout(ShaderHandle shader, const VertexAttributeParam* pVertexAttributeParams, size_t numVertexAttributes);
+		void                     DestroyVertexLayout(VertexLayoutHandle vertexLayout);
 
-		VertexBuffer*            CreateVertexBuffer(const void* pVertices, size_t size, BufferUsage usage);
-		void                     DestroyVertexBuffer(VertexBuffer* pVertexBuffer);
+		VertexBufferHandle       CreateVertexBuffer(const void* pVertices, size_t size, BufferUsage usage);
+		void                     DestroyVertexBuffer(VertexBufferHandle vertexBuffer);
 
-		void*                    MapVertexBuffer(VertexBuffer* pVertexBuffer, BufferAccess access);
-		void                     UnmapVertexBuffer(VertexBuffer* pVertexBuffer);
-		void                     SetVertexBufferData(VertexBuffer* pVertexBuffer, const void* pVertices, size_t size);
+		void*                    MapVertexBuffer(VertexBufferHandle vertexBuffer, BufferAccess access);
+		void                     UnmapVertexBuffer(VertexBufferHandle vertexBuffer);
+		void                     SetVertexBufferData(VertexBufferHandle vertexBuffer, const void* pVertices, size_t size);
 
-		IndexBuffer*             CreateIndexBuffer(uint32* pIndices, size_t numIndices, BufferUsage usage);
-		void                     DestroyIndexBuffer(IndexBuffer* pIndexBuffer);
+		IndexBufferHandle        CreateIndexBuffer(uint32* pIndices, size_t numIndices, BufferUsage usage);
+		void                     DestroyIndexBuffer(IndexBufferHandle indexBuffer);
 
-		void*                    MapIndexBuffer(IndexBuffer* pIndexBuffer, BufferAccess access);
-		void                     UnmapIndexBuffer(IndexBuffer* pIndexBuffer);
-		void                     SetIndexBufferData(IndexBuffer* pIndexBuffer, uint32* pIndices, size_t numIndices);
-		size_t                   GetIndexBufferNumIndices(const IndexBuffer* pIndexBuffer);
+		void*                    MapIndexBuffer(IndexBufferHandle indexBuffer, BufferAccess access);
+		void                     UnmapIndexBuffer(IndexBufferHandle indexBuffer);
+		void                     SetIndexBufferData(IndexBufferHandle indexBuffer, uint32* pIndices, size_t numIndices);
+		size_t                   GetIndexBufferNumIndices(IndexBufferHandle indexBuffer);
 
-		VertexArray*             CreateVertexArray(VertexLayout* pVertexLayout, const VertexBuffer** pVertexBuffers, size_t numVertexBuffers, IndexBuffer* pIndexBuffer);
-		void                     DestroyVertexArray(VertexArray* pVertexArray);
+		VertexArrayHandle        CreateVertexArray(VertexLayoutHandle vertexLayout, const VertexBufferHandle* pVertexBuffers, size_t numVertexBuffers, IndexBufferHandle indexBuffer);
+		void                     DestroyVertexArray(VertexArrayHandle vertexArray);
 
 		/* 'size' must be 16 bytes aligned.
 			'pName' is the name of the uniform in the shader.
@@ -290,19 +302,19 @@ namespace iol
 			} material;
 
 			'pName' would be 'UB_material'. */
-		UniformBuffer*           CreateUniformBuffer(const void* pData, size_t size, BufferUsage usage, const char* pName);
-		void                     DestroyUniformBuffer(UniformBuffer* pBuffer);
+		UniformBufferHandle      CreateUniformBuffer(const void* pData, size_t size, BufferUsage usage, const char* pName);
+		void                     DestroyUniformBuffer(UniformBufferHandle buffer);
 
-		void*                    MapUniformBuffer(UniformBuffer* pBuffer, BufferAccess access);
-		void                     UnmapUniformBuffer(UniformBuffer* pBuffer);
-		void                     SetUniformBufferData(UniformBuffer* pBuffer, const void* pData, size_t size);
+		void*                    MapUniformBuffer(UniformBufferHandle buffer, BufferAccess access);
+		void                     UnmapUniformBuffer(UniformBufferHandle buffer);
+		void                     SetUniformBufferData(UniformBufferHandle buffer, const void* pData, size_t size);
 
-		Texture*                 CreateTextureFromFile(const char* pFilePath, const TextureParam& param);
-		Texture*                 CreateTexture(uint32 width, uint32 height, uint32 color, const TextureParam& param);
-		void                     DestroyTexture(Texture* pTexture);
+		TextureHandle            CreateTextureFromFile(const char* pFilePath, const TextureParam& param);
+		TextureHandle            CreateTexture(uint32 width, uint32 height, uint32 color, const TextureParam& param);
+		void                     DestroyTexture(TextureHandle texture);
 
-		RenderTarget*            CreateRenderTarget(uint32 width, uint32 height, RenderTargetFlags flags);
-		void                     DestroyRenderTarget(RenderTarget* pRenderTarget);
+		RenderTargetHandle       CreateRenderTarget(uint32 width, uint32 height, RenderTargetFlags flags);
+		void                     DestroyRenderTarget(RenderTargetHandle renderTarget);
 
 	private:
 		struct GraphicsSystemData* m_data;
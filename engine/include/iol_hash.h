@@ -0,0 +1,121 @@
+#ifndef IOLITE_HASH_H
+#define IOLITE_HASH_H
+
+#include "iol_definitions.h"
+
+#include <type_traits>
+
+// Forces the string hash to be evaluated at compile time, e.g. for uniform names and asset ids
+#define iol_hash_string(str) (std::integral_constant<uint64, iol::hash::String(str)>::value)
+
+namespace iol
+{
+	namespace hash
+	{
+		/*
+		* Fast 64-bit hash over arbitrary bytes, inputs longer than 128 bytes are processed with SSE2/NEON.
+		* The result is the same on every platform and code path. Not suited for cryptography.
+		*/
+		uint64                  Bytes(const void* pData, size_t size, uint64 seed = 0);
+
+		iol_inline constexpr uint32 Mix32(uint32 value)
+		{
+			value ^= value >> 16;
+			value *= 0x85EBCA6Bu;
+			value ^= value >> 13;
+			value *= 0xC2B2AE35u;
+			value ^= value >> 16;
+			return value;
+		}
+
+		iol_inline constexpr uint64 Mix64(uint64 value)
+		{
+			value ^= value >> 33;
+			value *= 0xFF51AFD7ED558CCDull;
+			value ^= value >> 33;
+			value *= 0xC4CEB9FE1A85EC53ull;
+			value ^= value >> 33;
+			return value;
+		}
+
+		iol_inline constexpr uint64 Combine(uint64 seed, uint64 value)
+		{
+			return Mix64(seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2)));
+		}
+
+		/*
+		* FNV-1a with a final mix, meant for short names.
+		* Usable at compile time, the runtime result of the same string is identical.
+		*/
+		iol_inline constexpr uint64 String(const char* pString, size_t length)
+		{
+			uint64 hash = 0xCBF29CE484222325ull;
+
+			for (size_t i = 0; i < length; i++)
+			{
+				hash ^= (uint8)pString[i];
+				hash *= 0x100000001B3ull;
+			}
+
+			return Mix64(hash);
+		}
+
+		iol_inline constexpr uint64 String(const char* pString)
+		{
+			uint64 hash = 0xCBF29CE484222325ull;
+
+			for (; *pString != 0; pString++)
+			{
+				hash ^= (uint8)*pString;
+				hash *= 0x100000001B3ull;
+			}
+
+			return Mix64(hash);
+		}
+	}
+
+	/*
+	* Default hash function of Hashmap and FlatHashmap.
+	* Types without a specialization are hashed by their bytes, which requires that they have no padding.
+	*/
+	template<typename T, typename Enable = void>
+	struct Hash
+	{
+		static uint32 Get(const T& key)
+		{
+			static_assert(std::has_unique_object_representations<T>::value, "T has padding or floating point members, specialize iol::Hash<T>");
+			return (uint32)hash::Bytes(&key, sizeof(T));
+		}
+	};
+
+	template<typename T>
+	struct Hash<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type>
+	{
+		static uint32 Get(const T& key)
+		{
+			return (uint32)hash::Mix64((uint64)key);
+		}
+	};
+
+	template<typename T>
+	struct Hash<T*>
+	{
+		static uint32 Get(T* const& key)
+		{
+			return (uint32)hash::Mix64((uint64)(uintptr_t)key);
+		}
+	};
+
+	template<typename T>
+	struct Hash<T, typename std::enable_if<std::is_same<T, float>::value || std::is_same<T, double>::value>::type>
+	{
+		static uint32 Get(const T& key)
+		{
+			// +0 and -0 compare equal and must have the same hash
+			T value = (key == 0) ? 0 : key;
+			return (uint32)hash::Bytes(&value, sizeof(T));
+		}
+	};
+}
+
+#endif // IOLITE_HASH_H
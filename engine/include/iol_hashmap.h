@@ -2,6 +2,8 @@
 #define IOL_HASHMAP_H
 
 #include "iol_definitions.h"
+#include "iol_memory.h"
+#include "iol_hash.h"
 
 namespace iol
 {
@@ -40,7 +42,8 @@ namespace iol
 		Hashmap(Hashmap&& other) = delete;
 		Hashmap& operator=(Hashmap&& other) = delete;
 
-		void      Create(uint32(*hashFunction)(const TKey& key), size_t capacity);
+		void      Create(size_t capacity, Allocator* pAllocator = nullptr);
+		void      Create(uint32(*hashFunction)(const TKey& key), size_t capacity, Allocator* pAllocator = nullptr);
 		void      Destroy();
 
 		void      Add(const TKey& key, const TValue& value);
@@ -55,6 +58,8 @@ namespace iol
 		Element** m_lists;
 		size_t m_numLists;
 		size_t m_count;
+		Allocator* m_pAllocator;
+		PoolAllocator m_elementPool;
 	};
 }
 
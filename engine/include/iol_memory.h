@@ -11,8 +11,15 @@
 #define iol_alloc_array(T, count)     (T*)iol::memory_alloc_helper(__FILE__, __LINE__, sizeof(T) * (count))
 #define iol_alloc_raw(size)           iol::memory_alloc_helper(__FILE__, __LINE__, size)
 #define iol_free(pMemory)             do { iol::memory_free_helper(__FILE__, __LINE__, pMemory); } while(0)
+#define iol_realloc(pMemory, size)    iol::memory_realloc_helper(__FILE__, __LINE__, pMemory, size)
 
-#define iol_new(T, ...)               new (iol::memory_alloc_helper(__FILE__, __LINE__, sizeof(T))) T(__VA_ARGS__)
+#define iol_alloc_aligned(T, alignment)                   (T*)iol::memory_alloc_aligned_helper(__FILE__, __LINE__, sizeof(T), alignment)
+#define iol_alloc_array_aligned(T, count, alignment)      (T*)iol::memory_alloc_aligned_helper(__FILE__, __LINE__, sizeof(T) * (count), alignment)
+#define iol_alloc_raw_aligned(size, alignment)            iol::memory_alloc_aligned_helper(__FILE__, __LINE__, size, alignment)
+#define iol_realloc_aligned(pMemory, size, alignment)     iol::memory_realloc_aligned_helper(__FILE__, __LINE__, pMemory, size, alignment)
+#define iol_free_aligned(pMemory)                         do { iol::memory_free_aligned_helper(__FILE__, __LINE__, pMemory); } while(0)
+
+#define iol_new(T, ...)               new (iol::memory_alloc_helper(__FILE__, __LINE__, iol::memory_new_size<T>())) T(__VA_ARGS__)
 #define iol_delete(pMemory)           \
     do { \
         if (pMemory) { \
@@ -36,8 +43,15 @@
 #define iol_alloc_array(T, count)     (T*)iol::memory_allocate(sizeof(T) * count)
 #define iol_alloc_raw(size)           iol::memory_allocate(size)
 #define iol_free(pMemory)             do { iol::memory_free(pMemory); } while(0)
+#define iol_realloc(pMemory, size)    iol::memory_realloc(pMemory, size)
+
+#define iol_alloc_aligned(T, alignment)                   (T*)iol::memory_allocate_aligned(sizeof(T), alignment)
+#define iol_alloc_array_aligned(T, count, alignment)      (T*)iol::memory_allocate_aligned(sizeof(T) * (count), alignment)
+#define iol_alloc_raw_aligned(size, alignment)            iol::memory_allocate_aligned(size, alignment)
+#define iol_realloc_aligned(pMemory, size, alignment)     iol::memory_realloc_aligned(pMemory, size, alignment)
+#define iol_free_aligned(pMemory)                         do { iol::memory_free_aligned(pMemory); } while(0)
 
-#define iol_new(T, ...)               new (iol::memory_allocate(sizeof(T))) T(__VA_ARGS__)
+#define iol_new(T, ...)               new (iol::memory_allocate(iol::memory_new_size<T>())) T(__VA_ARGS__)
 #define iol_delete(pMemory)           \
     do { \
         if (pMemory) { \
@@ -57,18 +71,147 @@
 
 #endif
 
+#define iol_alloc_cache_aligned(T)                  iol_alloc_aligned(T, MEMORY_CACHE_LINE_SIZE)
+#define iol_alloc_array_cache_aligned(T, count)     iol_alloc_array_aligned(T, count, MEMORY_CACHE_LINE_SIZE)
+
 namespace iol
 {
+	/*
+	* Interface for allocators that containers and systems can draw their storage from.
+	* Containers that are not given an allocator use the default heap (iol_alloc).
+	*/
+	class Allocator
+	{
+	public:
+		virtual ~Allocator() {}
+
+		virtual void*   Allocate(size_t size, size_t alignment) = 0;
+		virtual void*   Reallocate(void* pMemory, size_t oldSize, size_t newSize, size_t alignment) = 0;
+		virtual void    Free(void* pMemory) = 0;
+	};
+
+	/*
+	* General purpose allocator on top of the tracked heap functions.
+	*/
+	class HeapAllocator : public Allocator
+	{
+	public:
+		void*     Allocate(size_t size, size_t alignment) override;
+		void*     Reallocate(void* pMemory, size_t oldSize, size_t newSize, size_t alignment) override;
+		void      Free(void* pMemory) override;
+	};
+
+	/*
+	* Bump allocator over one fixed block of memory.
+	* An allocation costs a pointer bump, individual allocations are never freed.
+	* Only the most recent allocation can grow in place or be given back with Free().
+	* Reset() releases all allocations at once.
+	*/
+	class LinearAllocator : public Allocator
+	{
+	public:
+		LinearAllocator();
+		~LinearAllocator();
+
+		LinearAllocator(const LinearAllocator& other) = delete;
+		LinearAllocator& operator=(const LinearAllocator& other) = delete;
+
+		void      Create(size_t capacity, Allocator* pBackingAllocator = nullptr);
+		void      Destroy();
+		void*     Allocate(size_t size, size_t alignment = MEMORY_ALIGNMENT_DEFAULT) override;
+		void*     Reallocate(void* pMemory, size_t oldSize, size_t newSize, size_t alignment) override;
+		void      Free(void* pMemory) override;
+		void      Reset();
+
+		size_t    GetUsedSize() const { return m_offset; }
+		size_t    GetPeakSize() const { return m_peakSize; }
+		size_t    GetCapacity() const { return m_capacity; }
+
+	private:
+		Allocator* m_pBackingAllocator;
+		uint8* m_pBuffer;
+		size_t m_capacity;
+		size_t m_offset;
+		size_t m_lastOffset;
+		size_t m_peakSize;
+	};
+
+	/*
+	* Fixed size block allocator.
+	* Blocks are handed out in address order from chunks that double in size up to MEMORY_POOL_MAX_BLOCKS_PER_CHUNK,
+	* freed blocks are kept in a free list and reused first.
+	* Destroy() releases all chunks at once, without visiting the individual blocks.
+	*/
+	class PoolAllocator : public Allocator
+	{
+	public:
+		PoolAllocator();
+		~PoolAllocator();
+
+		PoolAllocator(const PoolAllocator& other) = delete;
+		PoolAllocator& operator=(const PoolAllocator& other) = delete;
+
+		void      Create(size_t blockSize, size_t initialBlocksPerChunk, size_t alignment = MEMORY_ALIGNMENT_DEFAULT, Allocator* pBackingAllocator = nullptr);
+		void      Destroy();
+		void*     Allocate();
+		void*     Allocate(size_t size, size_t alignment) override;
+		void*     Reallocate(void* pMemory, size_t oldSize, size_t newSize, size_t alignment) override;
+		void      Free(void* pBlock) override;
+
+		size_t    GetBlockSize() const { return m_blockSize; }
+		size_t    GetNumAllocatedBlocks() const { return m_numAllocatedBlocks; }
+
+	private:
+		struct Chunk
+		{
+			Chunk* pNext;
+		};
+
+		void AllocateChunk();
+
+		Allocator* m_pBackingAllocator;
+		void* m_pFreeList;
+		Chunk* m_pChunks;
+		uint8* m_pCursor;
+		uint8* m_pCursorEnd;
+		size_t m_blockSize;
+		size_t m_alignment;
+		size_t m_blocksPerChunk;
+		size_t m_numAllocatedBlocks;
+	};
+
 	namespace memory
 	{
 #ifndef IOL_MASTER
-		void    LogAllocations();
+		void              LogAllocations();
 #endif
-		void    FillZero(void* pDestination, size_t size);
-		void    Fill(void* pDestination, size_t size, int value);
-		void    Copy(void* pDestination, size_t size, const void* pSource);
-		void    Move(void* pDestination, size_t size, const void* pSource);
-		bool    Compare(const void* pFirst, const void* pSecond, size_t size);
+		void              FillZero(void* pDestination, size_t size);
+		void              Fill(void* pDestination, size_t size, int value);
+		void              Copy(void* pDestination, size_t size, const void* pSource);
+		void              Move(void* pDestination, size_t size, const void* pSource);
+		bool              Compare(const void* pFirst, const void* pSecond, size_t size);
+
+		/*
+		* The frame allocator is reset by engine::Run at the start of every frame.
+		* Use it for transient data only, nothing allocated from it may be kept beyond the current frame.
+		*/
+		void              CreateFrameAllocator(size_t capacity);
+		void              DestroyFrameAllocator();
+		void              ResetFrameAllocator();
+		LinearAllocator*  GetFrameAllocator();
+
+		HeapAllocator*    GetHeapAllocator();
+
+		/*
+		* Virtual memory. Reserved address space is not backed by physical memory until it is committed,
+		* committed memory reads as zero. Addresses and sizes passed to Commit/Decommit must be page aligned.
+		*/
+		size_t            GetPageSize();
+		void*             ReserveVirtual(size_t size);
+		void              ReleaseVirtual(void* pAddress, size_t size);
+		bool              CommitVirtual(void* pAddress, size_t size);
+		void              DecommitVirtual(void* pAddress, size_t size);
+		void              AdviseHugePages(void* pAddress, size_t size);
 	}
 }
 
@@ -3,6 +3,12 @@
 
 #include "iol_definitions.h"
 #include "iol_array.h"
+#include "iol_bit_set.h"
+#include "iol_file.h"
+
+#define MESH_BIN_MAGIC     0x48534D49u // "IMSH"
+#define MESH_BIN_VERSION   1u
+#define MESH_BIN_ALIGNMENT 16u
 
 namespace iol
 {
@@ -15,14 +21,54 @@ namespace iol
 		Capsule
 	};
 
+	enum MeshAttributeFlags
+	{
+		MeshAttributeFlags_None = 0,
+		MeshAttributeFlags_Position = iol_bit(0), // glm::vec3
+		MeshAttributeFlags_UV = iol_bit(1),       // glm::vec2
+		MeshAttributeFlags_Normal = iol_bit(2)    // glm::vec3
+	};
+
+	/*
+	* Header of an .iolmesh file, all values little endian.
+	* Every attribute block holds 'numVertices' elements, the index block 'numIndices' uint32.
+	* The blocks start at MESH_BIN_ALIGNMENT aligned offsets, an offset of 0 means the block is absent.
+	*/
+	struct MeshBinHeader
+	{
+		uint32 magic;
+		uint32 version;
+		uint32 attributes; // MeshAttributeFlags
+		uint32 indexSize;
+		uint64 sourceHash; // hash::Bytes of the file the mesh was converted from, 0 if unknown
+		uint64 numVertices;
+		uint64 numIndices;
+		float boundsMin[3];
+		float boundsMax[3];
+		uint64 positionsOffset;
+		uint64 uvsOffset;
+		uint64 normalsOffset;
+		uint64 indicesOffset;
+	};
+
 	class Mesh
 	{
 	public:
 		Mesh();
 		~Mesh();
 		
+		/*
+		* Converted meshes are cached as cache/mesh/<content hash>.iolmesh,
+		* loading the same file again maps the cache file instead of parsing the text.
+		* On a cache hit the arrays are read-only views like after LoadBinFile.
+		*/
 		bool    LoadObjFile(const char* filePath);
-		bool    WriteBinFile(const char* filePath);
+		bool    WriteBinFile(const char* filePath, uint64 sourceHash = 0);
+
+		/*
+		* Maps the file and points the arrays straight at it, nothing is copied.
+		* The arrays are read-only views until the next Load call or the destruction of the mesh.
+		*/
 		bool    LoadBinFile(const char* filePath);
 
 		void    LoadPrimitive(MeshPrimitiveType type);
@@ -33,12 +79,14 @@ namespace iol
 		void    LoadSphere();
 		void    LoadCapsule();
 		
-		bool    GetTrianglesInRadius(glm::vec3 pos, float radius, Array<uint32>& outIndices);
-		bool    GetTrianglesInRadiusIgnoreHeight(glm::vec3 pos, float radius, Array<uint32>& outIndices);
+		/* Sets the bit of every triangle whose center is within radius, outTriangles needs one bit per triangle. */
+		bool    GetTrianglesInRadius(glm::vec3 pos, float radius, BitSet& outTriangles);
+		bool    GetTrianglesInRadiusIgnoreHeight(glm::vec3 pos, float radius, BitSet& outTriangles);
 
 		size_t  GetVertexCount() const { return positions.count; }
 		size_t  GetIndexCount() const { return indices.count; }
 
+		// Views into a read-only file mapping after LoadBinFile or a cached LoadObjFile, writing to them crashes
 		Array<glm::vec3> positions;
 		Array<glm::vec2> uvs;
 		Array<glm::vec3> normals;
@@ -47,6 +95,12 @@ namespace iol
 		size_t terrainNumVerticesPerSide;
 		float terrainSize;
 		float terrainQuadSize;
+
+	private:
+		bool    LoadBinFile(const char* filePath, uint64 sourceHash, bool logErrors);
+		void    ReleaseBinFile();
+
+		FileMapping m_binFileMapping; // backs the arrays after LoadBinFile
 	};
 }
 
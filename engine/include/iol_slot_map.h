@@ -0,0 +1,95 @@
+#ifndef IOLITE_SLOT_MAP_H
+#define IOLITE_SLOT_MAP_H
+
+#include "iol_definitions.h"
+#include "iol_memory.h"
+
+#define SLOT_MAP_INDEX_BITS 20
+#define SLOT_MAP_GENERATION_BITS (32 - SLOT_MAP_INDEX_BITS)
+#define SLOT_MAP_INDEX_MASK ((1u << SLOT_MAP_INDEX_BITS) - 1)
+#define SLOT_MAP_GENERATION_MASK ((1u << SLOT_MAP_GENERATION_BITS) - 1)
+#define SLOT_MAP_MAX_CAPACITY (1u << SLOT_MAP_INDEX_BITS)
+#define SLOT_MAP_MIN_CAPACITY 16
+#define SLOT_MAP_INVALID_INDEX ((uint32)-1)
+
+namespace iol
+{
+	/*
+	* 32 bit handle to an element of a SlotMap<T>.
+	* The lower SLOT_MAP_INDEX_BITS bits are the slot index, the upper bits are the generation of the slot.
+	* Generations start at 1, so a zero initialized handle is never valid.
+	*/
+	template<typename T>
+	struct Handle
+	{
+		uint32 value;
+
+		bool     IsNull() const { return value == 0; }
+		uint32   GetIndex() const { return value & SLOT_MAP_INDEX_MASK; }
+		uint32   GetGeneration() const { return value >> SLOT_MAP_INDEX_BITS; }
+
+		bool     operator==(const Handle& other) const { return value == other.value; }
+		bool     operator!=(const Handle& other) const { return value != other.value; }
+	};
+
+	/*
+	* Elements are stored densely and addressed through generational handles.
+	* Add and Remove are O(1), Remove moves the last element into the gap, so pointers returned by Get() and GetData()
+	* are only valid until the next Add or Remove. Removing an element bumps the generation of its slot,
+	* handles to removed elements are detected by Get() returning nullptr.
+	* Free slots are reused in FIFO order, so a generation only wraps around after a slot was reused 2^SLOT_MAP_GENERATION_BITS times.
+	*/
+	template<typename T>
+	class SlotMap
+	{
+	public:
+		SlotMap();
+		~SlotMap();
+
+		SlotMap(const SlotMap& other) = delete;
+		SlotMap& operator=(const SlotMap& other) = delete;
+		SlotMap(SlotMap&& other) = delete;
+		SlotMap& operator=(SlotMap&& other) = delete;
+
+		void      Create(size_t capacity, Allocator* pAllocator = nullptr);
+		void      Destroy();
+		void      Clear();
+		void      Reserve(size_t capacity);
+
+		Handle<T> Add(const T& element);
+		Handle<T> Add(T&& element);
+		bool      Remove(Handle<T> handle);
+		T*        Get(Handle<T> handle) const;
+		bool      Contains(Handle<T> handle) const { return Get(handle) != nullptr; }
+
+		size_t    GetCount() const { return m_count; }
+		size_t    GetCapacity() const { return m_capacity; }
+		T*        GetData() const { return m_pElements; } // GetCount() elements in no particular order
+		Handle<T> GetHandle(size_t denseIndex) const;
+
+	private:
+		struct Slot
+		{
+			uint32 index; // dense index of the element, or the next free slot while the slot is unused
+			uint32 generation;
+		};
+
+		Slot*     FindSlot(Handle<T> handle) const;
+		void      AddFreeSlot(uint32 slotIndex);
+		void      Reallocate(size_t capacity);
+
+		Allocator* m_pAllocator;
+		T* m_pElements;
+		uint32* m_pSlotIndices; // slot index of every dense element, needed to patch the slot of the element that fills a gap
+		Slot* m_pSlots;
+		size_t m_capacity;
+		size_t m_count;
+		uint32 m_numSlots; // slots that were handed out at least once
+		uint32 m_freeHead;
+		uint32 m_freeTail;
+	};
+}
+
+#include "internal/slot_map_inl.h"
+
+#endif // IOLITE_SLOT_MAP_H
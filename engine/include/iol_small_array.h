@@ -0,0 +1,65 @@
+#ifndef IOLITE_SMALL_ARRAY_H
+#define IOLITE_SMALL_ARRAY_H
+
+#include "iol_definitions.h"
+#include "iol_debug.h"
+#include "iol_memory.h"
+
+namespace iol
+{
+	/*
+	* Array with room for N elements inside the object itself, only larger arrays allocate.
+	* It always grows like a growable Array. pData points into the object while the elements are stored inline,
+	* so a SmallArray can't be copied. Moving copies inline elements and takes over heap storage.
+	*/
+	template<typename T, size_t N>
+	struct SmallArray
+	{
+		SmallArray();
+		SmallArray(size_t _capacity);
+		SmallArray(size_t _capacity, Allocator* _pAllocator);
+		~SmallArray();
+
+		SmallArray(const SmallArray& other) = delete;
+		SmallArray& operator=(const SmallArray& other) = delete;
+		SmallArray(SmallArray&& other);
+		SmallArray& operator=(SmallArray&& other);
+
+		void     Create(size_t _capacity);
+		void     Create(size_t _capacity, Allocator* _pAllocator);
+		void     Destroy();
+		void     Clear();
+		void     Reserve(size_t _capacity);
+		void     Resize(size_t _count);
+		void     ShrinkToFit();
+		T&       PushBack();
+		T&       PushBack(const T& element);
+		T*       PushBackArray(const T* pElements, size_t count);
+		void     PopBack();
+		void     Remove(const T& element);
+		void     RemoveUnordered(const T& element);
+		void     RemoveAt(size_t index);
+		void     RemoveAtUnordered(size_t index);
+		bool     IsFull();
+		bool     IsInline() const { return pData == (const T*)m_inlineStorage; }
+
+		T&       operator[] (size_t index) { iol_assert(index < count); return pData[index]; }
+		const T& operator[] (size_t index) const { iol_assert(index < count); return pData[index]; }
+
+		T* pData;
+		size_t capacity;
+		size_t count;
+		Allocator* pAllocator; // if set, storage beyond N elements is taken from this allocator instead of the default heap
+
+	private:
+		void     Reallocate(size_t _capacity);
+		T*       AllocateStorage(size_t _capacity);
+		void     FreeStorage(T* pStorage);
+
+		alignas(T) uint8 m_inlineStorage[N * sizeof(T)];
+	};
+}
+
+#include "internal/small_array_inl.h"
+
+#endif // IOLITE_SMALL_ARRAY_H
@@ -0,0 +1,45 @@
+#ifndef IOLITE_SORT_H
+#define IOLITE_SORT_H
+
+#include "iol_definitions.h"
+#include "iol_memory.h"
+#include "iol_array.h"
+
+#define SORT_INSERTION_THRESHOLD 16
+#define SORT_PARALLEL_MIN_CHUNK (16 * 1024) // elements each thread sorts at least before ParallelSort uses another thread
+
+namespace iol
+{
+	/*
+	* Sort is an introsort: median of three quicksort that switches to heapsort when the recursion gets too deep
+	* and finishes small ranges with insertion sort. It isn't stable and works for any movable T.
+	*
+	* RadixSort is a stable LSD radix sort over the 8 bit digits of an unsigned 32 or 64 bit key returned by getKey.
+	* Digits that are equal for all keys are skipped, so keys that only use their low bits take fewer passes.
+	* Signed or float keys have to be mapped to unsigned keys with the same order by the caller.
+	*
+	* ParallelSort sorts one chunk per thread with Sort and merges the chunks pairwise, every merge is split across all threads.
+	* It is stable across chunks but not within them. Inputs that are too small for more than one chunk are sorted on the calling thread.
+	*
+	* RadixSort and ParallelSort need a temporary buffer of the same size as the input and only take trivially copyable elements.
+	*/
+	namespace sort
+	{
+		template<typename T, typename TLess> void Sort(T* pElements, size_t count, TLess less);
+		template<typename T, typename TLess> void Sort(Array<T>& array, TLess less);
+		template<typename T> void                 Sort(Array<T>& array);
+
+		template<typename T, typename TGetKey> void RadixSort(T* pElements, size_t count, TGetKey getKey, Allocator* pTempAllocator = nullptr);
+		template<typename T, typename TGetKey> void RadixSort(Array<T>& array, TGetKey getKey, Allocator* pTempAllocator = nullptr);
+		void                                        RadixSort(Array<uint32>& array, Allocator* pTempAllocator = nullptr);
+		void                                        RadixSort(Array<uint64>& array, Allocator* pTempAllocator = nullptr);
+
+		// numThreads 0 uses one thread per hardware thread
+		template<typename T, typename TLess> void ParallelSort(Array<T>& array, TLess less, uint32 numThreads = 0, Allocator* pTempAllocator = nullptr);
+		template<typename T> void                 ParallelSort(Array<T>& array);
+	}
+}
+
+#include "internal/sort_inl.h"
+
+#endif // IOLITE_SORT_H
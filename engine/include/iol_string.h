@@ -6,6 +6,24 @@
 
 namespace iol
 {
+	/*
+	* Non-owning view into a string, it is not necessarily null terminated.
+	* The view functions below never allocate, the viewed memory has to outlive the view.
+	*/
+	struct StringView
+	{
+		const char* pData;
+		size_t length;
+
+		StringView() : pData(nullptr), length(0) {}
+		StringView(const char* pString);
+		StringView(const char* pString, size_t length) : pData(pString), length(length) {}
+
+		const char* GetEnd() const { return pData + length; }
+		bool IsEmpty() const { return length == 0; }
+		char operator[](size_t index) const { return pData[index]; }
+	};
+
 	namespace string
 	{
 		char*        Create(size_t capacity);
@@ -28,6 +46,23 @@ namespace iol
 		char*        SubstringAlloc(const char* pStart, const char* pEnd);
 		void         Substring(const char* pStart, const char* pEnd, char* pOutStringBuffer, size_t capacity);
 		char*        ConcatAlloc(const char* pStringA, const char* pStringB);
+
+		StringView   CreateView(const char* pStart, const char* pEnd);
+		StringView   Substring(StringView view, size_t start, size_t length);
+		StringView   GetNextLine(StringView view);
+		StringView   SplitLine(StringView* pView); // returns the first line without the line break and advances pView past it
+		StringView   Split(StringView* pView, char delimiter); // returns the text up to the delimiter and advances pView past it
+		const char*  Find(StringView view, StringView toFind);
+		const char*  Find(StringView view, char character);
+		const char*  FindReverse(StringView view, StringView toFind);
+		bool         Contains(StringView view, StringView toFind);
+		bool         Equals(StringView view0, StringView view1);
+		bool         StartsWith(StringView view, StringView prefix);
+		bool         EndsWith(StringView view, StringView suffix);
+		StringView   Skip(StringView view, const char* charsToSkip);
+		StringView   TrimEnd(StringView view, const char* charsToTrim);
+		StringView   Trim(StringView view, const char* charsToTrim = " \t\r\n");
+		char*        Copy(char* pStringBuffer, StringView view, size_t capacity);
 	}
 }
 
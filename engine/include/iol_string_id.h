@@ -0,0 +1,50 @@
+#ifndef IOLITE_STRING_ID_H
+#define IOLITE_STRING_ID_H
+
+#include "iol_definitions.h"
+#include "iol_hash.h"
+
+#define STRING_ID_MAX_COUNT (1024 * 1024)
+#define STRING_ID_CHUNK_SIZE (64 * 1024)
+
+namespace iol
+{
+	/*
+	* Handle to a string in the global intern table.
+	* Equal strings always get the same id, so comparing and hashing ids never touches the text.
+	*/
+	struct StringId
+	{
+		uint32 value; // 0 is the invalid id
+
+		bool operator==(StringId other) const { return value == other.value; }
+		bool operator!=(StringId other) const { return value != other.value; }
+		bool IsValid() const { return value != 0; }
+	};
+
+	template<>
+	struct Hash<StringId>
+	{
+		static uint32 Get(const StringId& id)
+		{
+			return hash::Mix32(id.value);
+		}
+	};
+
+	namespace string_id
+	{
+		void          CreateSystem();
+		void          DestroySystem();
+
+		/* Interning and lookups are thread safe. The returned text stays valid until DestroySystem(). */
+		StringId      Intern(const char* pString);
+		StringId      Intern(const char* pString, size_t length);
+		StringId      Find(const char* pString); // returns an invalid id if the string was never interned
+		const char*   GetString(StringId id);
+		size_t        GetLength(StringId id);
+		uint64        GetHash(StringId id); // same value as hash::String and iol_hash_string for the text
+		size_t        GetCount();
+	}
+}
+
+#endif // IOLITE_STRING_ID_H
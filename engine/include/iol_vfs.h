@@ -0,0 +1,67 @@
+#ifndef IOLITE_VFS_H
+#define IOLITE_VFS_H
+
+#include "iol_definitions.h"
+#include "iol_file.h"
+
+#define VFS_ARCHIVE_MAGIC     0x4B415049u // "IPAK"
+#define VFS_ARCHIVE_VERSION   1u
+#define VFS_ARCHIVE_ALIGNMENT 4096u       // every entry starts on its own page
+
+namespace iol
+{
+	/*
+	* Archive layout, all values little endian:
+	* VfsArchiveHeader, 'numEntries' VfsArchiveEntry sorted by path hash, the path strings, then the entry data.
+	* Paths are stored relative to the packed directory with '/' separators and without a terminator.
+	*/
+	struct VfsArchiveHeader
+	{
+		uint32 magic;
+		uint32 version;
+		uint32 numEntries;
+		uint32 alignment;
+		uint64 stringsOffset;
+		uint64 stringsSize;
+	};
+
+	struct VfsArchiveEntry
+	{
+		uint64 pathHash; // hash::String of the path
+		uint64 offset;   // from the start of the archive
+		uint64 size;
+		uint32 pathOffset; // into the path strings
+		uint32 pathLength;
+	};
+
+	/*
+	* Virtual file system over loose directories and packed archives.
+	* A mount serves every path that starts with its mount point, e.g. "res/shader/basic.glsl" for the mount point "res".
+	* Later mounts take precedence, so loose files mounted after an archive override its entries during development.
+	* Paths that no mount serves are passed to the file system unchanged.
+	*/
+	namespace vfs
+	{
+		void    CreateSystem();
+		void    DestroySystem();
+		bool    MountArchive(const char* archivePath, const char* mountPoint);
+		bool    MountDirectory(const char* directoryPath, const char* mountPoint);
+
+		bool    Exists(const char* path);
+
+		/*
+		* Archive entries are views into the archive mapping, no system call or copy is involved.
+		* Always release the mapping with vfs::Unmap, never with file::Unmap.
+		*/
+		bool    Map(const char* path, FileMapping* pOutMapping);
+		void    Unmap(FileMapping* pMapping);
+
+		// Returns a newly allocated buffer with the file size + 1 byte for the termination character, free it with iol_free
+		char*   ReadAllText(const char* path, size_t* pOutFileSize);
+
+		// Packs every file below 'directoryPath' into a new archive
+		bool    PackDirectory(const char* directoryPath, const char* archivePath);
+	}
+}
+
+#endif // IOLITE_VFS_H
@@ -0,0 +1,64 @@
+#ifndef IOLITE_VIRTUAL_ARRAY_H
+#define IOLITE_VIRTUAL_ARRAY_H
+
+#include "iol_definitions.h"
+#include "iol_debug.h"
+#include "iol_memory.h"
+
+#define VIRTUAL_ARRAY_MIN_COMMIT_SIZE (64 * 1024)
+
+namespace iol
+{
+	enum VirtualArrayFlags
+	{
+		VirtualArrayFlags_None = 0,
+		VirtualArrayFlags_HugePages = iol_bit(0) // ask the OS to back the array with huge pages, useful for big vertex streams
+	};
+
+	/*
+	* Array that reserves address space for maxCapacity elements up front and commits pages on demand.
+	* Growing never copies or moves the elements, pointers into the array stay valid until Destroy().
+	*/
+	template<typename T>
+	struct VirtualArray
+	{
+		VirtualArray();
+		VirtualArray(size_t _maxCapacity, uint32 _flags = VirtualArrayFlags_None);
+		~VirtualArray();
+
+		VirtualArray(const VirtualArray& other) = delete;
+		VirtualArray& operator=(const VirtualArray& other) = delete;
+
+		bool     Create(size_t _maxCapacity, uint32 _flags = VirtualArrayFlags_None);
+		void     Destroy();
+		void     Clear();
+		void     Reserve(size_t _capacity);
+		void     Resize(size_t _count);
+		void     ShrinkToFit();
+		T&       PushBack();
+		T&       PushBack(const T& element);
+		T*       PushBackArray(const T* pElements, size_t count);
+		void     PopBack();
+		bool     IsFull() const { return count == maxCapacity; }
+
+		T&       operator[] (size_t index) { iol_assert(index < count); return pData[index]; }
+		const T& operator[] (size_t index) const { iol_assert(index < count); return pData[index]; }
+
+		T* pData;
+		size_t capacity; // number of elements in committed memory
+		size_t count;
+		size_t maxCapacity; // number of elements in reserved address space
+		uint32 flags; // see enum VirtualArrayFlags
+
+	private:
+		size_t   GetCommitGranularity() const;
+		void     Commit(size_t _capacity);
+
+		size_t m_reservedSize;
+		size_t m_committedSize;
+	};
+}
+
+#include "internal/virtual_array_inl.h"
+
+#endif // IOLITE_VIRTUAL_ARRAY_H
@@ -8,9 +8,19 @@
 #include "iol_debug.h"
 #include "iol_core.h"
 #include "iol_file.h"
+#include "iol_vfs.h"
+#include "iol_binary_stream.h"
 #include "iol_graphics.h"
 #include "iol_string.h"
+#include "iol_hash.h"
+#include "iol_string_id.h"
 #include "iol_array.h"
+#include "iol_small_array.h"
+#include "iol_slot_map.h"
+#include "iol_concurrent_queue.h"
+#include "iol_sort.h"
+#include "iol_bit_set.h"
+#include "iol_virtual_array.h"
 #include "iol_event.h"
 #include "iol_input.h"
 #include "iol_transform.h"
@@ -0,0 +1,460 @@
+#include "iol_binary_stream.h"
+#include "iol_core.h"
+#include "iol_debug.h"
+#include "iol_memory.h"
+#include "iol_string.h"
+
+namespace iol
+{
+	//-------------------------------------
+	// BinaryWriter
+	//-------------------------------------
+
+	BinaryWriter::BinaryWriter()
+	{
+		m_mode = BinaryStreamMode::None;
+		m_pFile = nullptr;
+		m_pBuffer = nullptr;
+		m_capacity = 0;
+		m_offset = 0;
+		m_flushedSize = 0;
+		m_ownsBuffer = false;
+		m_error = false;
+	}
+
+	BinaryWriter::~BinaryWriter()
+	{
+		Destroy();
+	}
+
+	void BinaryWriter::Create(File* pFile, size_t bufferSize)
+	{
+		iol_assert(m_mode == BinaryStreamMode::None);
+		iol_assert(pFile != nullptr);
+		iol_assert(bufferSize > 0);
+
+		m_mode = BinaryStreamMode::File;
+		m_pFile = pFile;
+		m_pBuffer = (uint8*)iol_alloc_raw(bufferSize);
+		m_capacity = bufferSize;
+		m_offset = 0;
+		m_flushedSize = 0;
+		m_ownsBuffer = true;
+		m_error = false;
+	}
+
+	void BinaryWriter::Create(void* pMemory, size_t capacity)
+	{
+		iol_assert(m_mode == BinaryStreamMode::None);
+		iol_assert(pMemory != nullptr || capacity == 0);
+
+		m_mode = BinaryStreamMode::Memory;
+		m_pFile = nullptr;
+		m_pBuffer = (uint8*)pMemory;
+		m_capacity = capacity;
+		m_offset = 0;
+		m_flushedSize = 0;
+		m_ownsBuffer = false;
+		m_error = false;
+	}
+
+	void BinaryWriter::CreateGrowable(size_t initialCapacity)
+	{
+		iol_assert(m_mode == BinaryStreamMode::None);
+		iol_assert(initialCapacity > 0);
+
+		m_mode = BinaryStreamMode::GrowableMemory;
+		m_pFile = nullptr;
+		m_pBuffer = (uint8*)iol_alloc_raw(initialCapacity);
+		m_capacity = initialCapacity;
+		m_offset = 0;
+		m_flushedSize = 0;
+		m_ownsBuffer = true;
+		m_error = false;
+	}
+
+	bool BinaryWriter::Destroy()
+	{
+		if (m_mode == BinaryStreamMode::None)
+			return true;
+
+		bool success = Flush();
+
+		if (m_ownsBuffer)
+			iol_free(m_pBuffer);
+
+		m_mode = BinaryStreamMode::None;
+		m_pFile = nullptr;
+		m_pBuffer = nullptr;
+		m_capacity = 0;
+		m_offset = 0;
+		m_flushedSize = 0;
+		m_ownsBuffer = false;
+		m_error = false;
+
+		return success;
+	}
+
+	bool BinaryWriter::Flush()
+	{
+		if (m_error)
+			return false;
+
+		if (m_mode != BinaryStreamMode::File || m_offset == 0)
+			return true;
+
+		if (!file::Write(m_pFile, m_pBuffer, m_offset))
+		{
+			iol_log_error("BinaryWriter: failed to write %zu bytes", m_offset);
+			m_error = true;
+			return false;
+		}
+
+		m_flushedSize += m_offset;
+		m_offset = 0;
+
+		return true;
+	}
+
+	bool BinaryWriter::WriteBytesSlow(const void* pData, size_t size)
+	{
+		if (m_error)
+			return false;
+
+		switch (m_mode)
+		{
+		case BinaryStreamMode::File:
+		{
+			if (!Flush())
+				return false;
+
+			// Large spans skip the buffer
+			if (size >= m_capacity)
+			{
+				if (!file::Write(m_pFile, pData, size))
+				{
+					iol_log_error("BinaryWriter: failed to write %zu bytes", size);
+					m_error = true;
+					return false;
+				}
+
+				m_flushedSize += size;
+				return true;
+			}
+
+			break;
+		}
+		case BinaryStreamMode::GrowableMemory:
+		{
+			size_t newCapacity = core::Max(m_capacity * 2, m_offset + size);
+			m_pBuffer = (uint8*)iol_realloc(m_pBuffer, newCapacity);
+			m_capacity = newCapacity;
+			break;
+		}
+		default:
+		{
+			iol_log_error("BinaryWriter: %zu bytes don't fit into the remaining %zu bytes", size, m_capacity - m_offset);
+			m_error = true;
+			return false;
+		}
+		}
+
+		memory::Copy(m_pBuffer + m_offset, size, pData);
+		m_offset += size;
+
+		return true;
+	}
+
+	bool BinaryWriter::WriteVarUint(uint64 value)
+	{
+		uint8 bytes[BINARY_STREAM_MAX_VARINT_SIZE];
+		size_t size = 0;
+
+		while (value >= 0x80)
+		{
+			bytes[size++] = (uint8)(value | 0x80);
+			value >>= 7;
+		}
+
+		bytes[size++] = (uint8)value;
+
+		return WriteBytes(bytes, size);
+	}
+
+	bool BinaryWriter::WriteVarInt(int64 value)
+	{
+		uint64 zigzag = ((uint64)value << 1) ^ (uint64)(value >> 63);
+		return WriteVarUint(zigzag);
+	}
+
+	bool BinaryWriter::WriteString(const char* pString)
+	{
+		iol_assert(pString != nullptr);
+
+		size_t length = string::GetLength(pString);
+
+		if (!WriteVarUint(length))
+			return false;
+
+		return WriteBytes(pString, length);
+	}
+
+	//-------------------------------------
+	// BinaryReader
+	//-------------------------------------
+
+	BinaryReader::BinaryReader()
+	{
+		m_mode = BinaryStreamMode::None;
+		m_pFile = nullptr;
+		m_pBuffer = nullptr;
+		m_pOwnedBuffer = nullptr;
+		m_capacity = 0;
+		m_size = 0;
+		m_offset = 0;
+		m_bufferPosition = 0;
+		m_fileStartPosition = 0;
+		m_error = false;
+	}
+
+	BinaryReader::~BinaryReader()
+	{
+		Destroy();
+	}
+
+	void BinaryReader::Create(File* pFile, size_t bufferSize)
+	{
+		iol_assert(m_mode == BinaryStreamMode::None);
+		iol_assert(pFile != nullptr);
+		iol_assert(bufferSize > 0);
+
+		m_mode = BinaryStreamMode::File;
+		m_pFile = pFile;
+		m_fileStartPosition = file::GetPosition(pFile);
+		m_pOwnedBuffer = (uint8*)iol_alloc_raw(bufferSize);
+		m_pBuffer = m_pOwnedBuffer;
+		m_capacity = bufferSize;
+		m_size = 0;
+		m_offset = 0;
+		m_bufferPosition = 0;
+		m_error = false;
+	}
+
+	void BinaryReader::Create(const void* pData, size_t size)
+	{
+		iol_assert(m_mode == BinaryStreamMode::None);
+		iol_assert(pData != nullptr || size == 0);
+
+		m_mode = BinaryStreamMode::Memory;
+		m_pFile = nullptr;
+		m_pOwnedBuffer = nullptr;
+		m_pBuffer = (const uint8*)pData;
+		m_capacity = size;
+		m_size = size;
+		m_offset = 0;
+		m_bufferPosition = 0;
+		m_fileStartPosition = 0;
+		m_error = false;
+	}
+
+	void BinaryReader::Destroy()
+	{
+		if (m_mode == BinaryStreamMode::None)
+			return;
+
+		if (m_pOwnedBuffer != nullptr)
+			iol_free(m_pOwnedBuffer);
+
+		m_mode = BinaryStreamMode::None;
+		m_pFile = nullptr;
+		m_pBuffer = nullptr;
+		m_pOwnedBuffer = nullptr;
+		m_capacity = 0;
+		m_size = 0;
+		m_offset = 0;
+		m_bufferPosition = 0;
+		m_fileStartPosition = 0;
+		m_error = false;
+	}
+
+	bool BinaryReader::Refill()
+	{
+		if (m_mode != BinaryStreamMode::File)
+			return false;
+
+		m_bufferPosition += m_size;
+		m_size = file::Read(m_pFile, m_pOwnedBuffer, m_capacity);
+		m_offset = 0;
+
+		return m_size > 0;
+	}
+
+	bool BinaryReader::ReadBytesSlow(void* pOutData, size_t size)
+	{
+		uint8* pOut = (uint8*)pOutData;
+
+		if (!m_error)
+		{
+			size_t available = m_size - m_offset;
+
+			if (available > 0)
+				memory::Copy(pOut, available, m_pBuffer + m_offset);
+
+			m_offset += available;
+			pOut += available;
+			size -= available;
+
+			if (m_mode == BinaryStreamMode::File)
+			{
+				if (size >= m_capacity)
+				{
+					// Large spans skip the buffer
+					size_t bytesRead = file::Read(m_pFile, pOut, size);
+					m_bufferPosition += m_size + bytesRead;
+					m_size = 0;
+					m_offset = 0;
+					pOut += bytesRead;
+					size -= bytesRead;
+				}
+				else if (Refill() && size <= m_size)
+				{
+					memory::Copy(pOut, size, m_pBuffer);
+					m_offset = size;
+					return true;
+				}
+			}
+
+			if (size == 0)
+				return true;
+
+			m_error = true;
+		}
+
+		if (size > 0)
+			memory::FillZero(pOut, size);
+
+		return false;
+	}
+
+	bool BinaryReader::ReadVarUint(uint64* pOutValue)
+	{
+		iol_assert(pOutValue != nullptr);
+
+		uint64 value = 0;
+
+		for (uint32 shift = 0; shift < 64; shift += 7)
+		{
+			uint8 byte;
+
+			if (!ReadBytes(&byte, 1))
+				break;
+
+			value |= (uint64)(byte & 0x7F) << shift;
+
+			if ((byte & 0x80) == 0)
+			{
+				*pOutValue = value;
+				return true;
+			}
+		}
+
+		// Truncated or longer than BINARY_STREAM_MAX_VARINT_SIZE
+		m_error = true;
+		*pOutValue = 0;
+
+		return false;
+	}
+
+	bool BinaryReader::ReadVarInt(int64* pOutValue)
+	{
+		iol_assert(pOutValue != nullptr);
+
+		uint64 zigzag;
+		bool success = ReadVarUint(&zigzag);
+		*pOutValue = (int64)(zigzag >> 1) ^ -(int64)(zigzag & 1);
+
+		return success;
+	}
+
+	bool BinaryReader::ReadString(char* pOutString, size_t capacity)
+	{
+		iol_assert(pOutString != nullptr);
+		iol_assert(capacity > 0);
+
+		pOutString[0] = '\0';
+
+		uint64 length;
+
+		if (!ReadVarUint(&length))
+			return false;
+
+		if (length >= capacity)
+		{
+			iol_log_error("BinaryReader: string of length %llu doesn't fit into %zu bytes", (unsigned long long)length, capacity);
+			m_error = true;
+			return false;
+		}
+
+		if (!ReadBytes(pOutString, (size_t)length))
+			return false;
+
+		pOutString[length] = '\0';
+
+		return true;
+	}
+
+	bool BinaryReader::Skip(size_t size)
+	{
+		if (m_error)
+			return false;
+
+		size_t available = m_size - m_offset;
+
+		if (size <= available)
+		{
+			m_offset += size;
+			return true;
+		}
+
+		if (m_mode == BinaryStreamMode::File)
+		{
+			size_t position = GetPosition() + size;
+			size_t filePosition = m_fileStartPosition + position;
+
+			if (filePosition <= file::GetSize(m_pFile) && file::SetPosition(m_pFile, filePosition))
+			{
+				m_bufferPosition = position;
+				m_size = 0;
+				m_offset = 0;
+				return true;
+			}
+		}
+
+		m_error = true;
+		return false;
+	}
+
+	const void* BinaryReader::ReadSpan(size_t size)
+	{
+		iol_assert(m_mode == BinaryStreamMode::Memory);
+
+		if (m_error || size > m_size - m_offset)
+		{
+			m_error = true;
+			return nullptr;
+		}
+
+		const void* pSpan = m_pBuffer + m_offset;
+		m_offset += size;
+
+		return pSpan;
+	}
+
+	bool BinaryReader::IsAtEnd()
+	{
+		if (m_offset < m_size)
+			return false;
+
+		return m_error || !Refill();
+	}
+}
@@ -0,0 +1,326 @@
+#include "iol_bit_set.h"
+#include "iol_core.h"
+#include <string.h>
+
+#if defined(IOL_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(IOL_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace iol
+{
+	static uint64* bit_set_allocate_words(size_t numWords, Allocator* pAllocator)
+	{
+		if (numWords == 0)
+			return nullptr;
+
+		uint64* pWords;
+
+		if (pAllocator != nullptr)
+			pWords = (uint64*)pAllocator->Allocate(sizeof(uint64) * numWords, alignof(uint64));
+		else
+			pWords = iol_alloc_array(uint64, numWords);
+
+		iol_assert(pWords != nullptr);
+		return pWords;
+	}
+
+	static void bit_set_free_words(uint64* pWords, Allocator* pAllocator)
+	{
+		if (pWords == nullptr)
+			return;
+
+		if (pAllocator != nullptr)
+			pAllocator->Free(pWords);
+		else
+			iol_free(pWords);
+	}
+
+#if defined(IOL_SIMD_SSE2)
+	// Bit slicing popcount, every byte ends up holding the number of bits it had set
+	static iol_inline __m128i bit_set_popcount_bytes(__m128i value)
+	{
+		const __m128i mask1 = _mm_set1_epi8(0x55);
+		const __m128i mask2 = _mm_set1_epi8(0x33);
+		const __m128i mask4 = _mm_set1_epi8(0x0F);
+
+		value = _mm_sub_epi8(value, _mm_and_si128(_mm_srli_epi64(value, 1), mask1));
+		value = _mm_add_epi8(_mm_and_si128(value, mask2), _mm_and_si128(_mm_srli_epi64(value, 2), mask2));
+		return _mm_and_si128(_mm_add_epi8(value, _mm_srli_epi64(value, 4)), mask4);
+	}
+#endif
+
+	BitSet::BitSet()
+	{
+		pWords = nullptr;
+		numBits = 0;
+		numWords = 0;
+		pAllocator = nullptr;
+	}
+
+	BitSet::BitSet(size_t _numBits, Allocator* _pAllocator)
+		: BitSet()
+	{
+		Create(_numBits, _pAllocator);
+	}
+
+	BitSet::~BitSet()
+	{
+		Destroy();
+	}
+
+	void BitSet::Create(size_t _numBits, Allocator* _pAllocator)
+	{
+		Destroy();
+
+		pAllocator = _pAllocator;
+		numBits = _numBits;
+		numWords = (_numBits + BIT_SET_WORD_BITS - 1) / BIT_SET_WORD_BITS;
+		pWords = bit_set_allocate_words(numWords, pAllocator);
+
+		if (numWords > 0)
+			memory::FillZero(pWords, sizeof(uint64) * numWords);
+	}
+
+	void BitSet::Destroy()
+	{
+		bit_set_free_words(pWords, pAllocator);
+
+		pWords = nullptr;
+		numBits = 0;
+		numWords = 0;
+	}
+
+	void BitSet::Resize(size_t _numBits)
+	{
+		size_t newNumWords = (_numBits + BIT_SET_WORD_BITS - 1) / BIT_SET_WORD_BITS;
+
+		if (newNumWords != numWords)
+		{
+			uint64* pNewWords = bit_set_allocate_words(newNumWords, pAllocator);
+			size_t numKeptWords = core::Min(numWords, newNumWords);
+
+			if (numKeptWords > 0)
+				memory::Copy(pNewWords, sizeof(uint64) * numKeptWords, pWords);
+
+			if (newNumWords > numKeptWords)
+				memory::FillZero(pNewWords + numKeptWords, sizeof(uint64) * (newNumWords - numKeptWords));
+
+			bit_set_free_words(pWords, pAllocator);
+			pWords = pNewWords;
+			numWords = newNumWords;
+		}
+
+		numBits = _numBits;
+		ClearUnusedBits();
+	}
+
+	void BitSet::ClearUnusedBits()
+	{
+		size_t numUsedBits = numBits % BIT_SET_WORD_BITS;
+
+		if (numUsedBits != 0)
+			pWords[numWords - 1] &= ~0ull >> (BIT_SET_WORD_BITS - numUsedBits);
+	}
+
+	void BitSet::SetRange(size_t first, size_t count)
+	{
+		iol_assert(first + count <= numBits);
+
+		if (count == 0)
+			return;
+
+		size_t last = first + count - 1;
+		size_t firstWord = first / BIT_SET_WORD_BITS;
+		size_t lastWord = last / BIT_SET_WORD_BITS;
+		uint64 firstMask = ~0ull << (first % BIT_SET_WORD_BITS);
+		uint64 lastMask = ~0ull >> (BIT_SET_WORD_BITS - 1 - last % BIT_SET_WORD_BITS);
+
+		if (firstWord == lastWord)
+		{
+			pWords[firstWord] |= firstMask & lastMask;
+			return;
+		}
+
+		pWords[firstWord] |= firstMask;
+		memset(pWords + firstWord + 1, 0xFF, sizeof(uint64) * (lastWord - firstWord - 1));
+		pWords[lastWord] |= lastMask;
+	}
+
+	void BitSet::ClearRange(size_t first, size_t count)
+	{
+		iol_assert(first + count <= numBits);
+
+		if (count == 0)
+			return;
+
+		size_t last = first + count - 1;
+		size_t firstWord = first / BIT_SET_WORD_BITS;
+		size_t lastWord = last / BIT_SET_WORD_BITS;
+		uint64 firstMask = ~0ull << (first % BIT_SET_WORD_BITS);
+		uint64 lastMask = ~0ull >> (BIT_SET_WORD_BITS - 1 - last % BIT_SET_WORD_BITS);
+
+		if (firstWord == lastWord)
+		{
+			pWords[firstWord] &= ~(firstMask & lastMask);
+			return;
+		}
+
+		pWords[firstWord] &= ~firstMask;
+		memset(pWords + firstWord + 1, 0, sizeof(uint64) * (lastWord - firstWord - 1));
+		pWords[lastWord] &= ~lastMask;
+	}
+
+	size_t BitSet::Count() const
+	{
+		size_t count = 0;
+		size_t i = 0;
+
+#if defined(IOL_SIMD_SSE2)
+		__m128i sum = _mm_setzero_si128();
+
+		for (; i + 2 <= numWords; i += 2)
+		{
+			__m128i bytes = bit_set_popcount_bytes(_mm_loadu_si128((const __m128i*)(pWords + i)));
+			sum = _mm_add_epi64(sum, _mm_sad_epu8(bytes, _mm_setzero_si128()));
+		}
+
+		alignas(16) uint64 lanes[2];
+		_mm_store_si128((__m128i*)lanes, sum);
+		count = (size_t)(lanes[0] + lanes[1]);
+#elif defined(IOL_SIMD_NEON)
+		uint64x2_t sum = vdupq_n_u64(0);
+
+		for (; i + 2 <= numWords; i += 2)
+		{
+			uint8x16_t bytes = vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(pWords + i)));
+			sum = vpadalq_u32(sum, vpaddlq_u16(vpaddlq_u8(bytes)));
+		}
+
+		count = (size_t)(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+#endif
+
+		for (; i < numWords; i++)
+			count += core::PopCount(pWords[i]);
+
+		return count;
+	}
+
+	bool BitSet::Any() const
+	{
+		for (size_t i = 0; i < numWords; i++)
+		{
+			if (pWords[i] != 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	size_t BitSet::FindNextSet(size_t index) const
+	{
+		if (index >= numBits)
+			return BIT_SET_INVALID_INDEX;
+
+		size_t wordIndex = index / BIT_SET_WORD_BITS;
+		uint64 word = pWords[wordIndex] & (~0ull << (index % BIT_SET_WORD_BITS));
+
+		while (word == 0)
+		{
+			if (++wordIndex == numWords)
+				return BIT_SET_INVALID_INDEX;
+
+			word = pWords[wordIndex];
+		}
+
+		return wordIndex * BIT_SET_WORD_BITS + core::CountTrailingZeros(word);
+	}
+
+	size_t BitSet::FindNextClear(size_t index) const
+	{
+		if (index >= numBits)
+			return BIT_SET_INVALID_INDEX;
+
+		size_t wordIndex = index / BIT_SET_WORD_BITS;
+		uint64 word = ~pWords[wordIndex] & (~0ull << (index % BIT_SET_WORD_BITS));
+
+		while (word == 0)
+		{
+			if (++wordIndex == numWords)
+				return BIT_SET_INVALID_INDEX;
+
+			word = ~pWords[wordIndex];
+		}
+
+		// The unused bits of the last word are 0 and show up as clear
+		size_t result = wordIndex * BIT_SET_WORD_BITS + core::CountTrailingZeros(word);
+		return result < numBits ? result : BIT_SET_INVALID_INDEX;
+	}
+
+	void BitSet::Or(const BitSet& other)
+	{
+		iol_assert(numBits == other.numBits);
+
+		size_t i = 0;
+
+#if defined(IOL_SIMD_SSE2)
+		for (; i + 2 <= numWords; i += 2)
+		{
+			__m128i a = _mm_loadu_si128((const __m128i*)(pWords + i));
+			__m128i b = _mm_loadu_si128((const __m128i*)(other.pWords + i));
+			_mm_storeu_si128((__m128i*)(pWords + i), _mm_or_si128(a, b));
+		}
+#elif defined(IOL_SIMD_NEON)
+		for (; i + 2 <= numWords; i += 2)
+			vst1q_u64(pWords + i, vorrq_u64(vld1q_u64(pWords + i), vld1q_u64(other.pWords + i)));
+#endif
+
+		for (; i < numWords; i++)
+			pWords[i] |= other.pWords[i];
+	}
+
+	void BitSet::And(const BitSet& other)
+	{
+		iol_assert(numBits == other.numBits);
+
+		size_t i = 0;
+
+#if defined(IOL_SIMD_SSE2)
+		for (; i + 2 <= numWords; i += 2)
+		{
+			__m128i a = _mm_loadu_si128((const __m128i*)(pWords + i));
+			__m128i b = _mm_loadu_si128((const __m128i*)(other.pWords + i));
+			_mm_storeu_si128((__m128i*)(pWords + i), _mm_and_si128(a, b));
+		}
+#elif defined(IOL_SIMD_NEON)
+		for (; i + 2 <= numWords; i += 2)
+			vst1q_u64(pWords + i, vandq_u64(vld1q_u64(pWords + i), vld1q_u64(other.pWords + i)));
+#endif
+
+		for (; i < numWords; i++)
+			pWords[i] &= other.pWords[i];
+	}
+
+	void BitSet::AndNot(const BitSet& other)
+	{
+		iol_assert(numBits == other.numBits);
+
+		size_t i = 0;
+
+#if defined(IOL_SIMD_SSE2)
+		for (; i + 2 <= numWords; i += 2)
+		{
+			__m128i a = _mm_loadu_si128((const __m128i*)(pWords + i));
+			__m128i b = _mm_loadu_si128((const __m128i*)(other.pWords + i));
+			_mm_storeu_si128((__m128i*)(pWords + i), _mm_andnot_si128(b, a));
+		}
+#elif defined(IOL_SIMD_NEON)
+		for (; i + 2 <= numWords; i += 2)
+			vst1q_u64(pWords + i, vbicq_u64(vld1q_u64(pWords + i), vld1q_u64(other.pWords + i)));
+#endif
+
+		for (; i < numWords; i++)
+			pWords[i] &= ~other.pWords[i];
+	}
+}
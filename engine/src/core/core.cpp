@@ -1,8 +1,10 @@
 #include "iol_core.h"
 #include "iol_debug.h"
 #include "iol_mesh.h"
+#include "iol_small_array.h"
 #include <chrono>
 #include <float.h>
+#include <thread>
 
 using namespace glm;
 
@@ -30,6 +32,27 @@ namespace iol
 		return sec;
 	}
 
+	uint32 core::GetHardwareThreadCount()
+	{
+		uint32 numThreads = std::thread::hardware_concurrency();
+		return numThreads > 0 ? numThreads : 1;
+	}
+
+	void core::RunTasks(uint32 numTasks, void(*function)(uint32 taskIndex, void* pUserData), void* pUserData)
+	{
+		iol_assert(numTasks > 0 && numTasks <= CORE_MAX_TASKS);
+
+		std::thread threads[CORE_MAX_TASKS - 1];
+
+		for (uint32 i = 1; i < numTasks; i++)
+			threads[i - 1] = std::thread(function, i, pUserData);
+
+		function(0, pUserData);
+
+		for (uint32 i = 1; i < numTasks; i++)
+			threads[i - 1].join();
+	}
+
 	vec3 core::CreateDirection(float pitch, float yaw)
 	{
 		vec3 direction;
@@ -79,11 +102,11 @@ namespace iol
 		return false; // No hit
 	}
 
-	bool core::RayIntersectsMesh(vec3 rayOrigin, vec3 rayDir, const Mesh& mesh, float& t, vec3& hitPoint, Array<uint32>& hitTriangleIndices)
+	bool core::RayIntersectsMesh(vec3 rayOrigin, vec3 rayDir, const Mesh& mesh, float& t, vec3& hitPoint, SmallArray<uint32, 3>& hitTriangleIndices)
 	{
 		vec3 closestHit;
 		float closestHitDistance = FLT_MAX;
-		hitTriangleIndices.Create(3);
+		hitTriangleIndices.Clear();
 
 		for (uint32 i = 0; i < mesh.indices.count; i += 3)
 		{
@@ -3,9 +3,12 @@
 #include "iol_graphics.h"
 #include "iol_memory.h"
 #include "iol_event.h"
+#include "iol_file.h"
+#include "iol_vfs.h"
 #include "iol_input.h"
 #include "iol_core.h"
 #include "iol_application.h"
+#include "iol_string_id.h"
 #include <SDL.h>
 #include <thread>
 #include <chrono>
@@ -37,6 +40,9 @@ namespace iol
 	{
 		s_engine.params = params;
 
+		memory::CreateFrameAllocator(params.frameAllocatorCapacity);
+		string_id::CreateSystem();
+
 		int result = SDL_Init(SDL_INIT_EVERYTHING);
 
 		if (result != 0)
@@ -48,6 +54,19 @@ namespace iol
 		EventSystemParam eventSystemParam;
 		event_system::Create(eventSystemParam);
 
+		FileIoParam fileIoParam;
+		fileIoParam.numThreads = params.numFileIoThreads;
+		file::CreateIoSystem(fileIoParam);
+
+		vfs::CreateSystem();
+
+		// Loose files are only a fallback, a directory mount on top of the archive would stat every asset path
+		bool archiveMounted = params.assetArchivePath != nullptr && file::Exists(params.assetArchivePath) &&
+			vfs::MountArchive(params.assetArchivePath, params.assetMountPoint);
+
+		if (!archiveMounted && params.assetDirectoryPath != nullptr && file::Exists(params.assetDirectoryPath))
+			vfs::MountDirectory(params.assetDirectoryPath, params.assetMountPoint);
+
 		input::CreateSystem();
 
 		uint32 windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE;
@@ -85,6 +104,8 @@ namespace iol
 
 		while (!s_engine.quit)
 		{
+			memory::ResetFrameAllocator();
+
 			double lastTime = timeFrameStart;
 			timeFrameStart = core::GetCurrentTimeSeconds();
 			float dt = (float)(timeFrameStart - lastTime);
@@ -92,6 +113,7 @@ namespace iol
 
 			input::UpdateSystem(dt);
 			PollEvents(&s_engine.quit);
+			file::UpdateIoSystem();
 			event_system::Update(dt);
 
 			app->Update(dt);
@@ -118,7 +140,11 @@ namespace iol
 		iol_delete(s_engine.graphicsSystem);
 		SDL_DestroyWindow(s_engine.window);
 		SDL_Quit();
+		vfs::DestroySystem();
+		file::DestroyIoSystem();
 		event_system::Destroy();
+		string_id::DestroySystem();
+		memory::DestroyFrameAllocator();
 	}
 
 	void engine::PollEvents(bool* quit)
@@ -1,4 +1,7 @@
 #include "iol_event.h"
+#include "iol_small_array.h"
+
+#define EVENT_SYSTEM_INLINE_LISTENERS 2
 
 namespace iol
 {
@@ -18,10 +21,12 @@ namespace iol
 		}
 	};
 
+	typedef SmallArray<EventListener, EVENT_SYSTEM_INLINE_LISTENERS> EventListenerArray;
+
 	struct EventSystemData
 	{
 		EventSystemParam param;
-		Array<EventListener>* listenerMap;
+		EventListenerArray* listenerMap; // most event types have one or two listeners
 		size_t listenerMapSize;
 		Array<Event> events;
 	};
@@ -38,12 +43,11 @@ namespace iol
 		eventSystem->events.Create(param.maxBufferedEvents);
 
 		eventSystem->listenerMapSize = param.maxEventTypes;
-		eventSystem->listenerMap = iol_new_array(Array<EventListener>, eventSystem->listenerMapSize);
+		eventSystem->listenerMap = iol_new_array(EventListenerArray, eventSystem->listenerMapSize);
 
 		for (int i = 0; i < eventSystem->listenerMapSize; ++i)
 		{
-			new(&eventSystem->listenerMap[i]) Array<EventListener*>();
-			eventSystem->listenerMap[i].Create(param.maxEventListeners);
+			new(&eventSystem->listenerMap[i]) EventListenerArray();
 		}
 	}
 
@@ -66,7 +70,7 @@ namespace iol
 		while (eventSystem->events.count > 0)
 		{
 			Event& evt = eventSystem->events[0];
-			const Array<EventListener>& listeners = eventSystem->listenerMap[evt.type];
+			const EventListenerArray& listeners = eventSystem->listenerMap[evt.type];
 
 			for (size_t i = 0; i < listeners.count; ++i)
 			{
@@ -85,6 +89,7 @@ namespace iol
 	void event_system::AddListener(uint32 eventType, HandleEvent_t callback, void* userData)
 	{
 		iol_assert(eventType < eventSystem->listenerMapSize);
+		iol_assert(eventSystem->listenerMap[eventType].count < eventSystem->param.maxEventListeners);
 
 		EventListener listener;
 		listener.callback = callback;
@@ -9,6 +9,15 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef IOL_PLATFORM_WINDOWS
+#include "platform_internal.h"
+#elif defined(IOL_PLATFORM_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace iol
 {
 	struct File
@@ -66,15 +75,15 @@ namespace iol
 		{
 			if (file_CanWrite(mode))
 			{
-				// Try to create all directories for the filePath
-				static char s_directoryPath[1024];
-				file::GetDirectoryPath(pFilePath, s_directoryPath, sizeof(s_directoryPath));
+				// Try to create all directories for the filePath. Stack buffers, the file io workers open files concurrently
+				char directoryPath[1024];
+				file::GetDirectoryPath(pFilePath, directoryPath, sizeof(directoryPath));
 
 #define IOL_MKDIR_CMD_CAPACITY 2048
-				static char mkdirCommand[IOL_MKDIR_CMD_CAPACITY];
+				char mkdirCommand[IOL_MKDIR_CMD_CAPACITY];
 
 #ifdef IOL_PLATFORM_WINDOWS
-				sprintf(mkdirCommand, "mkdir %s", s_directoryPath);
+				sprintf(mkdirCommand, "mkdir %s", directoryPath);
 				char* pMkdir = mkdirCommand;
 				while (*pMkdir)
 				{
@@ -83,7 +92,7 @@ namespace iol
 					++pMkdir;
 				}
 #elif defined(IOL_PLATFORM_LINUX)
-				snprintf(mkdirCommand, IOL_MKDIR_CMD_CAPACITY, "mkdir -p %s", s_directoryPath);
+				snprintf(mkdirCommand, IOL_MKDIR_CMD_CAPACITY, "mkdir -p %s", directoryPath);
 #else
 #error not implemented
 #endif
@@ -218,6 +227,143 @@ namespace iol
 		return file->position;
 	}
 
+	bool file::Exists(const char* pPath)
+	{
+		iol_assert(pPath != nullptr);
+
+#ifdef IOL_PLATFORM_WINDOWS
+		return GetFileAttributesA(pPath) != INVALID_FILE_ATTRIBUTES;
+#elif defined(IOL_PLATFORM_LINUX)
+		struct stat pathStat;
+		return stat(pPath, &pathStat) == 0;
+#else
+#error not implemented
+#endif
+	}
+
+	bool file::Map(const char* pFilePath, FileMapping* pOutMapping, uint32 flags)
+	{
+		iol_assert(pFilePath != nullptr);
+		iol_assert(pOutMapping != nullptr);
+
+		pOutMapping->pData = nullptr;
+		pOutMapping->size = 0u;
+		pOutMapping->pHandle = nullptr;
+
+#ifdef IOL_PLATFORM_WINDOWS
+		DWORD fileFlags = (flags & FileMapFlags_Sequential) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+		HANDLE fileHandle = CreateFileA(pFilePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, fileFlags, nullptr);
+
+		if (fileHandle == INVALID_HANDLE_VALUE)
+		{
+			iol_log_error("failed to open file: %s", pFilePath);
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+
+		if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(fileHandle);
+			return false;
+		}
+
+		// The mapping object keeps the file open, the file handle isn't needed anymore
+		HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(fileHandle);
+
+		if (mappingHandle == nullptr)
+		{
+			iol_log_error("failed to map file: %s", pFilePath);
+			return false;
+		}
+
+		void* pData = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+		if (pData == nullptr)
+		{
+			iol_log_error("failed to map file: %s", pFilePath);
+			CloseHandle(mappingHandle);
+			return false;
+		}
+
+		if (flags & FileMapFlags_WillNeed)
+		{
+			WIN32_MEMORY_RANGE_ENTRY range;
+			range.VirtualAddress = pData;
+			range.NumberOfBytes = (SIZE_T)fileSize.QuadPart;
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+		}
+
+		pOutMapping->pData = (const uint8*)pData;
+		pOutMapping->size = (size_t)fileSize.QuadPart;
+		pOutMapping->pHandle = mappingHandle;
+#elif defined(IOL_PLATFORM_LINUX)
+		int fd = open(pFilePath, O_RDONLY | O_CLOEXEC);
+
+		if (fd < 0)
+		{
+			iol_log_error("failed to open file: %s", pFilePath);
+			return false;
+		}
+
+		struct stat fileStat;
+
+		if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			close(fd);
+			return false;
+		}
+
+		size_t size = (size_t)fileStat.st_size;
+		void* pData = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		// The mapping holds its own reference to the file
+		close(fd);
+
+		if (pData == MAP_FAILED)
+		{
+			iol_log_error("failed to map file: %s", pFilePath);
+			return false;
+		}
+
+		// Only hints, the mapping is valid either way
+		if (flags & FileMapFlags_Sequential)
+			madvise(pData, size, MADV_SEQUENTIAL);
+
+		if (flags & FileMapFlags_WillNeed)
+			madvise(pData, size, MADV_WILLNEED);
+
+		pOutMapping->pData = (const uint8*)pData;
+		pOutMapping->size = size;
+#else
+#error not implemented
+#endif
+
+		return true;
+	}
+
+	void file::Unmap(FileMapping* pMapping)
+	{
+		iol_assert(pMapping != nullptr);
+
+		if (pMapping->pData == nullptr)
+			return;
+
+#ifdef IOL_PLATFORM_WINDOWS
+		UnmapViewOfFile(pMapping->pData);
+		CloseHandle((HANDLE)pMapping->pHandle);
+#elif defined(IOL_PLATFORM_LINUX)
+		munmap((void*)pMapping->pData, pMapping->size);
+#else
+#error not implemented
+#endif
+
+		pMapping->pData = nullptr;
+		pMapping->size = 0u;
+		pMapping->pHandle = nullptr;
+	}
+
 	bool file::GetDirectoryPath(const char* pFilePath, char* pDirectoryPath, size_t directoryPathSize)
 	{
 		pDirectoryPath[0] = '\0';
@@ -0,0 +1,410 @@
+#include "iol_file.h"
+#include "iol_array.h"
+#include "iol_concurrent_queue.h"
+#include "iol_core.h"
+#include "iol_debug.h"
+#include "iol_event.h"
+#include "iol_memory.h"
+#include "iol_string.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#define FILE_IO_MAX_THREADS 8
+
+namespace iol
+{
+	struct FileIoRequest
+	{
+		FileIoRequestId id;
+		FileIoOperation operation;
+		FileIoPriority priority;
+		uint64 sequence; // submission order, keeps requests of the same priority FIFO
+		char* pFilePath;
+		const void* pData;
+		size_t size;
+		void* pUserData;
+	};
+
+	struct FileIoCompletion
+	{
+		FileIoRequestId id;
+		FileIoOperation operation;
+		FileIoStatus status;
+		void* pData;
+		size_t size;
+		void* pUserData;
+	};
+
+	struct FileIoSystemData
+	{
+		FileIoParam param;
+		std::mutex mutex;
+		std::condition_variable requestAvailable;
+		Array<FileIoRequest> pendingRequests; // binary max heap, guarded by mutex
+		FileIoRequestId nextRequestId;
+		uint64 nextSequence;
+		bool quit;
+
+		MpmcQueue<FileIoCompletion> completions; // filled by the workers
+		Array<FileIoCompletion> cancelledRequests; // main thread only, the main thread must never wait on the full completion queue
+
+		std::thread threads[FILE_IO_MAX_THREADS];
+		uint32 numThreads;
+		std::atomic<uint32> numRunningWorkers;
+	};
+
+	static FileIoSystemData* s_fileIo = nullptr;
+
+	//-------------------------------------
+	// Request heap
+	//-------------------------------------
+
+	static bool file_io_is_before(const FileIoRequest& a, const FileIoRequest& b)
+	{
+		if (a.priority != b.priority)
+			return a.priority > b.priority;
+
+		return a.sequence < b.sequence;
+	}
+
+	static void file_io_sift_up(Array<FileIoRequest>& heap, size_t index)
+	{
+		while (index > 0)
+		{
+			size_t parent = (index - 1) / 2;
+
+			if (!file_io_is_before(heap[index], heap[parent]))
+				break;
+
+			core::Swap(&heap[index], &heap[parent]);
+			index = parent;
+		}
+	}
+
+	static void file_io_sift_down(Array<FileIoRequest>& heap, size_t index)
+	{
+		for (size_t child = index * 2 + 1; child < heap.count; child = index * 2 + 1)
+		{
+			if (child + 1 < heap.count && file_io_is_before(heap[child + 1], heap[child]))
+				child++;
+
+			if (!file_io_is_before(heap[child], heap[index]))
+				break;
+
+			core::Swap(&heap[index], &heap[child]);
+			index = child;
+		}
+	}
+
+	static FileIoRequest file_io_remove_request(Array<FileIoRequest>& heap, size_t index)
+	{
+		FileIoRequest request = heap[index];
+		heap[index] = heap[heap.count - 1];
+		heap.PopBack();
+
+		if (index < heap.count)
+		{
+			file_io_sift_down(heap, index);
+			file_io_sift_up(heap, index);
+		}
+
+		return request;
+	}
+
+	//-------------------------------------
+	// Worker threads
+	//-------------------------------------
+
+	static FileIoStatus file_io_read(const FileIoRequest& request, FileIoCompletion* pCompletion)
+	{
+		File* pFile = file::Open(request.pFilePath, FileMode::BinaryRead);
+
+		if (pFile == nullptr)
+			return FileIoStatus::Failed;
+
+		size_t size = file::GetSize(pFile);
+		char* pBuffer = (char*)iol_alloc_raw(size + 1);
+		size_t bytesRead = size > 0 ? file::Read(pFile, pBuffer, size) : 0;
+		file::Close(pFile);
+
+		if (bytesRead != size)
+		{
+			iol_log_error("failed to read file: %s", request.pFilePath);
+			iol_free(pBuffer);
+			return FileIoStatus::Failed;
+		}
+
+		pBuffer[size] = '\0';
+		pCompletion->pData = pBuffer;
+		pCompletion->size = size;
+
+		return FileIoStatus::Completed;
+	}
+
+	static FileIoStatus file_io_write(const FileIoRequest& request, FileIoCompletion* pCompletion)
+	{
+		pCompletion->pData = (void*)request.pData;
+
+		File* pFile = file::Open(request.pFilePath, FileMode::BinaryWrite);
+
+		if (pFile == nullptr)
+			return FileIoStatus::Failed;
+
+		bool success = request.size == 0 || file::Write(pFile, request.pData, request.size);
+		file::Close(pFile);
+
+		if (!success)
+		{
+			iol_log_error("failed to write file: %s", request.pFilePath);
+			return FileIoStatus::Failed;
+		}
+
+		pCompletion->size = request.size;
+
+		return FileIoStatus::Completed;
+	}
+
+	static void file_io_worker(FileIoSystemData* pSystem)
+	{
+		for (;;)
+		{
+			FileIoRequest request;
+
+			{
+				std::unique_lock<std::mutex> lock(pSystem->mutex);
+				pSystem->requestAvailable.wait(lock, [pSystem] { return pSystem->quit || pSystem->pendingRequests.count > 0; });
+
+				if (pSystem->quit)
+					break;
+
+				request = file_io_remove_request(pSystem->pendingRequests, 0);
+			}
+
+			FileIoCompletion completion;
+			completion.id = request.id;
+			completion.operation = request.operation;
+			completion.pData = nullptr;
+			completion.size = 0;
+			completion.pUserData = request.pUserData;
+
+			if (request.operation == FileIoOperation::Read)
+				completion.status = file_io_read(request, &completion);
+			else
+				completion.status = file_io_write(request, &completion);
+
+			iol_free(request.pFilePath);
+
+			// The main thread drains the queue once per frame
+			while (!pSystem->completions.TryPush(completion))
+				std::this_thread::yield();
+		}
+
+		pSystem->numRunningWorkers--;
+	}
+
+	//-------------------------------------
+
+	static FileIoRequestId file_io_submit(FileIoRequest& request)
+	{
+		iol_assert(s_fileIo != nullptr);
+
+		request.pFilePath = string::CopyAlloc(request.pFilePath);
+
+		{
+			std::lock_guard<std::mutex> lock(s_fileIo->mutex);
+
+			// Skip 0 when the id wraps around, it marks an invalid request
+			if (++s_fileIo->nextRequestId == 0)
+				s_fileIo->nextRequestId = 1;
+
+			request.id = s_fileIo->nextRequestId;
+			request.sequence = s_fileIo->nextSequence++;
+
+			s_fileIo->pendingRequests.PushBack(request);
+			file_io_sift_up(s_fileIo->pendingRequests, s_fileIo->pendingRequests.count - 1);
+		}
+
+		s_fileIo->requestAvailable.notify_one();
+
+		return request.id;
+	}
+
+	static void file_io_send_event(const FileIoCompletion& completion)
+	{
+		Event evt;
+		evt.type = EventType_FileIoCompleted;
+		evt.data.fileIoCompleted.requestId = completion.id;
+		evt.data.fileIoCompleted.operation = completion.operation;
+		evt.data.fileIoCompleted.status = completion.status;
+		evt.data.fileIoCompleted.pData = completion.pData;
+		evt.data.fileIoCompleted.size = completion.size;
+		evt.data.fileIoCompleted.pUserData = completion.pUserData;
+		event_system::SendEvent(evt);
+	}
+
+	void file::CreateIoSystem(const FileIoParam& param)
+	{
+		iol_assert(s_fileIo == nullptr);
+
+		uint32 numThreads = core::Clamp(param.numThreads, 1u, (uint32)FILE_IO_MAX_THREADS);
+
+		if (numThreads != param.numThreads)
+		{
+			iol_log_warning("CreateIoSystem: %u threads requested, using %u", param.numThreads, numThreads);
+		}
+
+		// The completion queue keeps its positions on separate cache lines, which iol_new doesn't align for
+		void* pMemory = iol_alloc_raw_aligned(sizeof(FileIoSystemData), alignof(FileIoSystemData));
+		s_fileIo = new (pMemory) FileIoSystemData();
+		s_fileIo->param = param;
+		s_fileIo->pendingRequests.CreateGrowable(64);
+		s_fileIo->nextRequestId = 0;
+		s_fileIo->nextSequence = 0;
+		s_fileIo->quit = false;
+		s_fileIo->completions.Create(param.completionQueueCapacity);
+		s_fileIo->cancelledRequests.CreateGrowable(16);
+		s_fileIo->numThreads = numThreads;
+		s_fileIo->numRunningWorkers = numThreads;
+
+		for (uint32 i = 0; i < s_fileIo->numThreads; i++)
+			s_fileIo->threads[i] = std::thread(file_io_worker, s_fileIo);
+	}
+
+	void file::DestroyIoSystem()
+	{
+		iol_assert(s_fileIo != nullptr);
+
+		{
+			std::lock_guard<std::mutex> lock(s_fileIo->mutex);
+			s_fileIo->quit = true;
+		}
+
+		s_fileIo->requestAvailable.notify_all();
+
+		// A worker may wait for room in the full completion queue, keep draining until all of them are done
+		FileIoCompletion completion;
+
+		for (;;)
+		{
+			bool workersRunning = s_fileIo->numRunningWorkers.load() > 0;
+
+			while (s_fileIo->completions.TryPop(&completion))
+			{
+				if (completion.operation == FileIoOperation::Read)
+					iol_free(completion.pData);
+			}
+
+			if (!workersRunning)
+				break;
+
+			std::this_thread::yield();
+		}
+
+		for (uint32 i = 0; i < s_fileIo->numThreads; i++)
+			s_fileIo->threads[i].join();
+
+		for (size_t i = 0; i < s_fileIo->pendingRequests.count; i++)
+			iol_free(s_fileIo->pendingRequests[i].pFilePath);
+
+		s_fileIo->pendingRequests.Destroy();
+		s_fileIo->cancelledRequests.Destroy();
+		s_fileIo->completions.Destroy();
+		s_fileIo->~FileIoSystemData();
+		iol_free_aligned(s_fileIo);
+		s_fileIo = nullptr;
+	}
+
+	void file::UpdateIoSystem()
+	{
+		iol_assert(s_fileIo != nullptr);
+
+		size_t numEvents = 0;
+
+		while (numEvents < s_fileIo->param.maxCompletionEventsPerUpdate && s_fileIo->cancelledRequests.count > 0)
+		{
+			file_io_send_event(s_fileIo->cancelledRequests[0]);
+			s_fileIo->cancelledRequests.RemoveAt(0);
+			numEvents++;
+		}
+
+		FileIoCompletion completion;
+
+		while (numEvents < s_fileIo->param.maxCompletionEventsPerUpdate && s_fileIo->completions.TryPop(&completion))
+		{
+			file_io_send_event(completion);
+			numEvents++;
+		}
+	}
+
+	FileIoRequestId file::ReadAsync(const char* pFilePath, FileIoPriority priority, void* pUserData)
+	{
+		iol_assert(pFilePath != nullptr);
+
+		FileIoRequest request;
+		request.operation = FileIoOperation::Read;
+		request.priority = priority;
+		request.pFilePath = (char*)pFilePath;
+		request.pData = nullptr;
+		request.size = 0;
+		request.pUserData = pUserData;
+
+		return file_io_submit(request);
+	}
+
+	FileIoRequestId file::WriteAsync(const char* pFilePath, const void* pData, size_t size, FileIoPriority priority, void* pUserData)
+	{
+		iol_assert(pFilePath != nullptr);
+		iol_assert(pData != nullptr || size == 0);
+
+		FileIoRequest request;
+		request.operation = FileIoOperation::Write;
+		request.priority = priority;
+		request.pFilePath = (char*)pFilePath;
+		request.pData = pData;
+		request.size = size;
+		request.pUserData = pUserData;
+
+		return file_io_submit(request);
+	}
+
+	bool file::CancelAsync(FileIoRequestId requestId)
+	{
+		iol_assert(s_fileIo != nullptr);
+
+		FileIoRequest request;
+		bool found = false;
+
+		{
+			std::lock_guard<std::mutex> lock(s_fileIo->mutex);
+			Array<FileIoRequest>& pendingRequests = s_fileIo->pendingRequests;
+
+			for (size_t i = 0; i < pendingRequests.count; i++)
+			{
+				if (pendingRequests[i].id == requestId)
+				{
+					request = file_io_remove_request(pendingRequests, i);
+					found = true;
+					break;
+				}
+			}
+		}
+
+		if (!found)
+			return false;
+
+		iol_free(request.pFilePath);
+
+		FileIoCompletion& completion = s_fileIo->cancelledRequests.PushBack();
+		completion.id = request.id;
+		completion.operation = request.operation;
+		completion.status = FileIoStatus::Cancelled;
+		completion.pData = (void*)request.pData;
+		completion.size = 0;
+		completion.pUserData = request.pUserData;
+
+		return true;
+	}
+}
@@ -0,0 +1,262 @@
+#include "iol_hash.h"
+#include "iol_debug.h"
+#include <string.h>
+
+#if defined(IOL_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(IOL_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#define HASH_STRIPE_SIZE 64
+#define HASH_STRIPES_PER_BLOCK 16
+#define HASH_PRIME32_1 0x9E3779B1u
+#define HASH_PRIME64_1 0x9E3779B185EBCA87ull
+
+namespace iol
+{
+	// Stripe n of a block is keyed with s_secret[n .. n + 7], the block scramble uses s_secret[16 .. 23]
+	alignas(16) static const uint64 s_secret[24] =
+	{
+		0x01F10654D95AFC9Bull, 0xFA6D2F67B38279B5ull, 0x35394E2DAC651A24ull, 0x1581408D7E4FD4ADull,
+		0x9FE4628E25BA5FBFull, 0x56468922912DF5BEull, 0x17EAC99BBEA7818Dull, 0x31A444CD2D0F4934ull,
+		0xDB837F4399139141ull, 0x713A4A8AF0942E68ull, 0x06CE4BC4C0BADA38ull, 0x595EDB7FD4942392ull,
+		0x009C87118DFDAF64ull, 0x7166E781B005FDDFull, 0xDC277E6262902F05ull, 0x0EFECCFED3565BBFull,
+		0xDCDB8B0259220B2Cull, 0x963C5B3468733E64ull, 0x32E5A029332D94B1ull, 0xF82E9676BD1F090Dull,
+		0x4B04CC9621CC387Cull, 0xC5A2F9F3743AB63Bull, 0x3384D516A0A8F479ull, 0x4A65DCA849CC24ACull,
+	};
+
+	static iol_inline uint64 hash_read64(const uint8* p)
+	{
+		uint64 value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static iol_inline uint32 hash_read32(const uint8* p)
+	{
+		uint32 value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	// Multiplies to 128 bits and folds the halves together
+	static iol_inline uint64 hash_mul128_fold64(uint64 a, uint64 b)
+	{
+#if defined(__SIZEOF_INT128__)
+		__uint128_t product = (__uint128_t)a * b;
+		return (uint64)product ^ (uint64)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		uint64 high;
+		uint64 low = _umul128(a, b, &high);
+		return low ^ high;
+#else
+		uint64 lowLow = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+		uint64 highLow = (a >> 32) * (b & 0xFFFFFFFF);
+		uint64 lowHigh = (a & 0xFFFFFFFF) * (b >> 32);
+		uint64 highHigh = (a >> 32) * (b >> 32);
+		uint64 cross = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+		uint64 high = highHigh + (highLow >> 32) + (cross >> 32);
+		uint64 low = (cross << 32) | (lowLow & 0xFFFFFFFF);
+		return low ^ high;
+#endif
+	}
+
+	static iol_inline uint64 hash_mix16(const uint8* p, uint64 key0, uint64 key1, uint64 seed)
+	{
+		return hash_mul128_fold64(hash_read64(p) ^ (key0 + seed), hash_read64(p + 8) ^ (key1 - seed));
+	}
+
+	static uint64 hash_bytes_0_to_16(const uint8* p, size_t size, uint64 seed)
+	{
+		if (size > 8)
+		{
+			uint64 low = hash_read64(p) ^ (s_secret[0] + seed);
+			uint64 high = hash_read64(p + size - 8) ^ (s_secret[1] - seed);
+			return hash::Mix64(size + low + high + hash_mul128_fold64(low, high));
+		}
+
+		if (size >= 4)
+		{
+			uint64 value = hash_read32(p + size - 4) + ((uint64)hash_read32(p) << 32);
+			return hash::Mix64((value ^ (s_secret[2] + seed)) + size);
+		}
+
+		if (size > 0)
+		{
+			uint32 combined = ((uint32)p[0] << 16) | ((uint32)p[size >> 1] << 24) | (uint32)p[size - 1] | ((uint32)size << 8);
+			return hash::Mix64(combined ^ (s_secret[3] + seed));
+		}
+
+		return hash::Mix64(seed ^ s_secret[4]);
+	}
+
+	static uint64 hash_bytes_17_to_128(const uint8* p, size_t size, uint64 seed)
+	{
+		uint64 acc = size * HASH_PRIME64_1;
+
+		// Pairs of 16 byte chunks from the front and the back, they overlap for sizes that are not a multiple of 32
+		if (size > 32)
+		{
+			if (size > 64)
+			{
+				if (size > 96)
+				{
+					acc += hash_mix16(p + 48, s_secret[12], s_secret[13], seed);
+					acc += hash_mix16(p + size - 64, s_secret[14], s_secret[15], seed);
+				}
+
+				acc += hash_mix16(p + 32, s_secret[8], s_secret[9], seed);
+				acc += hash_mix16(p + size - 48, s_secret[10], s_secret[11], seed);
+			}
+
+			acc += hash_mix16(p + 16, s_secret[4], s_secret[5], seed);
+			acc += hash_mix16(p + size - 32, s_secret[6], s_secret[7], seed);
+		}
+
+		acc += hash_mix16(p, s_secret[0], s_secret[1], seed);
+		acc += hash_mix16(p + size - 16, s_secret[2], s_secret[3], seed);
+
+		return hash::Mix64(acc);
+	}
+
+	/*
+	* Long inputs keep 8 accumulators that every 64 byte stripe is folded into:
+	*   acc[i] += low32(key) * high32(key), acc[i ^ 1] += data[i], with key = data[i] ^ secret[stripe + i]
+	* After every block of 16 stripes the accumulators are scrambled. The SIMD paths compute exactly the same values.
+	*/
+#if defined(IOL_SIMD_SSE2)
+	static iol_inline void hash_accumulate_stripe(uint64* pAcc, const uint8* p, const uint64* pSecret)
+	{
+		__m128i* pAccVec = (__m128i*)pAcc;
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			__m128i data = _mm_loadu_si128((const __m128i*)(p + i * 16));
+			__m128i key = _mm_xor_si128(data, _mm_loadu_si128((const __m128i*)(pSecret + i * 2)));
+			__m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+			__m128i dataSwapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+			pAccVec[i] = _mm_add_epi64(pAccVec[i], _mm_add_epi64(product, dataSwapped));
+		}
+	}
+
+	static iol_inline void hash_scramble(uint64* pAcc, const uint64* pSecret)
+	{
+		__m128i* pAccVec = (__m128i*)pAcc;
+		const __m128i prime = _mm_set1_epi32((int)HASH_PRIME32_1);
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			__m128i acc = pAccVec[i];
+			acc = _mm_xor_si128(acc, _mm_srli_epi64(acc, 47));
+			acc = _mm_xor_si128(acc, _mm_loadu_si128((const __m128i*)(pSecret + i * 2)));
+
+			// 64 x 32 bit multiply from two 32 x 32 -> 64 bit products
+			__m128i productLow = _mm_mul_epu32(acc, prime);
+			__m128i productHigh = _mm_mul_epu32(_mm_srli_epi64(acc, 32), prime);
+			pAccVec[i] = _mm_add_epi64(productLow, _mm_slli_epi64(productHigh, 32));
+		}
+	}
+#elif defined(IOL_SIMD_NEON)
+	static iol_inline void hash_accumulate_stripe(uint64* pAcc, const uint8* p, const uint64* pSecret)
+	{
+		for (size_t i = 0; i < 4; i++)
+		{
+			uint64x2_t acc = vld1q_u64(pAcc + i * 2);
+			uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(p + i * 16));
+			uint64x2_t key = veorq_u64(data, vld1q_u64(pSecret + i * 2));
+			uint64x2_t product = vmull_u32(vmovn_u64(key), vshrn_n_u64(key, 32));
+			uint64x2_t dataSwapped = vextq_u64(data, data, 1);
+			vst1q_u64(pAcc + i * 2, vaddq_u64(acc, vaddq_u64(product, dataSwapped)));
+		}
+	}
+
+	static iol_inline void hash_scramble(uint64* pAcc, const uint64* pSecret)
+	{
+		for (size_t i = 0; i < 4; i++)
+		{
+			uint64x2_t acc = vld1q_u64(pAcc + i * 2);
+			acc = veorq_u64(acc, vshrq_n_u64(acc, 47));
+			acc = veorq_u64(acc, vld1q_u64(pSecret + i * 2));
+
+			uint64x2_t productHigh = vshlq_n_u64(vmull_n_u32(vshrn_n_u64(acc, 32), HASH_PRIME32_1), 32);
+			vst1q_u64(pAcc + i * 2, vmlal_n_u32(productHigh, vmovn_u64(acc), HASH_PRIME32_1));
+		}
+	}
+#else
+	static iol_inline void hash_accumulate_stripe(uint64* pAcc, const uint8* p, const uint64* pSecret)
+	{
+		for (size_t i = 0; i < 8; i++)
+		{
+			uint64 data = hash_read64(p + i * 8);
+			uint64 key = data ^ pSecret[i];
+			pAcc[i ^ 1] += data;
+			pAcc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+		}
+	}
+
+	static iol_inline void hash_scramble(uint64* pAcc, const uint64* pSecret)
+	{
+		for (size_t i = 0; i < 8; i++)
+		{
+			uint64 acc = pAcc[i];
+			acc ^= acc >> 47;
+			acc ^= pSecret[i];
+			acc *= HASH_PRIME32_1;
+			pAcc[i] = acc;
+		}
+	}
+#endif
+
+	static uint64 hash_bytes_long(const uint8* p, size_t size, uint64 seed)
+	{
+		alignas(16) uint64 acc[8] =
+		{
+			0x165667B1u + seed, HASH_PRIME64_1 - seed, 0xC2B2AE3D27D4EB4Full + seed, 0x165667B19E3779F9ull - seed,
+			0x85EBCA77C2B2AE63ull + seed, 0x85EBCA77u - seed, 0x27D4EB2F165667C5ull + seed, HASH_PRIME32_1 - seed
+		};
+
+		// The last stripe is read from the end of the input and may overlap the full stripes
+		size_t numStripes = (size - 1) / HASH_STRIPE_SIZE;
+		size_t stripe = 0;
+
+		for (size_t i = 0; i < numStripes; i++)
+		{
+			hash_accumulate_stripe(acc, p + i * HASH_STRIPE_SIZE, s_secret + stripe);
+
+			if (++stripe == HASH_STRIPES_PER_BLOCK)
+			{
+				hash_scramble(acc, s_secret + HASH_STRIPES_PER_BLOCK);
+				stripe = 0;
+			}
+		}
+
+		hash_accumulate_stripe(acc, p + size - HASH_STRIPE_SIZE, s_secret + 7);
+
+		uint64 result = size * HASH_PRIME64_1;
+
+		for (size_t i = 0; i < 4; i++)
+			result += hash_mul128_fold64(acc[i * 2] ^ s_secret[11 + i * 2], acc[i * 2 + 1] ^ s_secret[12 + i * 2]);
+
+		return hash::Mix64(result);
+	}
+
+	uint64 hash::Bytes(const void* pData, size_t size, uint64 seed)
+	{
+		iol_assert(pData != nullptr || size == 0);
+
+		const uint8* p = (const uint8*)pData;
+
+		if (size <= 16)
+			return hash_bytes_0_to_16(p, size, seed);
+
+		if (size <= 128)
+			return hash_bytes_17_to_128(p, size, seed);
+
+		return hash_bytes_long(p, size, seed);
+	}
+}
\ No newline at end of file
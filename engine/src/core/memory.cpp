@@ -1,16 +1,41 @@
 #include "iol_memory.h"
 #include "iol_core.h"
 #include "iol_debug.h"
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <mutex>
+
+#ifdef IOL_PLATFORM_WINDOWS
+#include "platform_internal.h"
+#elif defined(IOL_PLATFORM_LINUX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace iol
 {
+	// Stored in front of every aligned allocation
+	struct AlignedHeader
+	{
+		size_t offset; // from the malloc'ed base to the returned pointer
+		size_t size;
+		size_t alignment;
+	};
+
+	// malloc returns 16 byte aligned blocks on 64-bit targets and 8 byte aligned blocks on 32-bit targets.
+	// alignof(max_align_t) is no help here, MSVC x64 reports 8 although its malloc aligns to 16.
+	static constexpr size_t s_mallocAlignment = sizeof(void*) >= 8 ? 16 : 8;
+	static constexpr bool s_mallocHonorsDefaultAlignment = s_mallocAlignment >= MEMORY_ALIGNMENT_DEFAULT;
+
 	void* memory_allocate(size_t size)
 	{
 		iol_assert(size > 0);
 
+		if (!s_mallocHonorsDefaultAlignment)
+			return memory_allocate_aligned(size, MEMORY_ALIGNMENT_DEFAULT);
+
 		void* pMemory = malloc(size);
 		iol_assert(pMemory != nullptr);
 
@@ -20,6 +45,13 @@ namespace iol
 	void memory_free(void* pMemory)
 	{
 		iol_assert(pMemory != nullptr);
+
+		if (!s_mallocHonorsDefaultAlignment)
+		{
+			memory_free_aligned(pMemory);
+			return;
+		}
+
 		free(pMemory);
 	}
 
@@ -27,96 +59,271 @@ namespace iol
 	{
 		iol_assert(pMemory != nullptr);
 
-		return realloc(pMemory, newSize);
+		if (!s_mallocHonorsDefaultAlignment)
+			return memory_realloc_aligned(pMemory, newSize, MEMORY_ALIGNMENT_DEFAULT);
+
+		void* pNewMemory = realloc(pMemory, newSize);
+		iol_assert(pNewMemory != nullptr);
+
+		return pNewMemory;
+	}
+
+	void* memory_allocate_aligned(size_t size, size_t alignment)
+	{
+		iol_assert(size > 0);
+		iol_assert(core::IsPowerOfTwo(alignment));
+
+		alignment = core::Max(alignment, alignof(AlignedHeader));
+
+		uint8* pBase = (uint8*)malloc(size + alignment - 1 + sizeof(AlignedHeader));
+		iol_assert(pBase != nullptr);
+
+		if (pBase == nullptr)
+			return nullptr;
+
+		uint8* pMemory = (uint8*)core::Align((uintptr_t)pBase + sizeof(AlignedHeader), alignment);
+
+		AlignedHeader* pHeader = (AlignedHeader*)pMemory - 1;
+		pHeader->offset = pMemory - pBase;
+		pHeader->size = size;
+		pHeader->alignment = alignment;
+
+		return pMemory;
+	}
+
+	void memory_free_aligned(void* pMemory)
+	{
+		iol_assert(pMemory != nullptr);
+
+		AlignedHeader* pHeader = (AlignedHeader*)pMemory - 1;
+		free((uint8*)pMemory - pHeader->offset);
+	}
+
+	void* memory_realloc_aligned(void* pMemory, size_t newSize, size_t alignment)
+	{
+		iol_assert(pMemory != nullptr);
+		iol_assert(newSize > 0);
+		iol_assert(core::IsPowerOfTwo(alignment));
+
+		alignment = core::Max(alignment, alignof(AlignedHeader));
+
+		AlignedHeader header = *((AlignedHeader*)pMemory - 1);
+
+		// The old offset depends on the old alignment, reserve enough padding that the bytes behind it stay inside the new block
+		size_t padding = core::Max(alignment, header.alignment) - 1;
+		uint8* pBase = (uint8*)realloc((uint8*)pMemory - header.offset, newSize + padding + sizeof(AlignedHeader));
+		iol_assert(pBase != nullptr);
+
+		if (pBase == nullptr)
+			return nullptr;
+
+		uint8* pNewMemory = (uint8*)core::Align((uintptr_t)pBase + sizeof(AlignedHeader), alignment);
+
+		// realloc keeps the bytes relative to the base, move them if the aligned start has shifted
+		if (pNewMemory != pBase + header.offset)
+			memmove(pNewMemory, pBase + header.offset, core::Min(header.size, newSize));
+
+		AlignedHeader* pHeader = (AlignedHeader*)pNewMemory - 1;
+		pHeader->offset = pNewMemory - pBase;
+		pHeader->size = newSize;
+		pHeader->alignment = alignment;
+
+		return pNewMemory;
 	}
 
 #ifndef IOL_MASTER
-	AllocationInfo	g_allocations[MEMORY_MAX_TRACKED_ALLOCATIONS];
+	// The tracking tables use malloc directly, so they never show up in their own bookkeeping.
+	// Both are open addressing tables with linear probing and a power of two capacity.
 
-	void memory_alloc_info_set(AllocationInfo* pInfo, const char* pFile, size_t line, void* _pMemory, size_t _size)
+	struct AllocationSiteTable
 	{
-		pInfo->slotUsed = true;
-		snprintf(pInfo->fileLineString, sizeof(pInfo->fileLineString), "[%s:%zu]", pFile, line);
-		pInfo->pMemory = _pMemory;
-		pInfo->size = _size;
+		AllocationSite* pSites;
+		uint32* pSlots; // siteIndex + 1, 0 means empty
+		size_t numSites;
+		size_t sitesCapacity;
+		size_t slotsCapacity;
+	};
+
+	struct AllocationTable
+	{
+		AllocationInfo* pSlots; // pMemory == nullptr means empty
+		size_t count;
+		size_t capacity;
+	};
+
+	static std::mutex s_trackingMutex;
+	static AllocationSiteTable s_sites;
+	static AllocationTable s_allocations;
+
+	static size_t memory_tracking_hash(const void* pKey, size_t line)
+	{
+		uint64 hash = (uint64)(uintptr_t)pKey ^ ((uint64)line << 32);
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 33;
+		return (size_t)hash;
 	}
 
-	void memory_alloc_info_clear(AllocationInfo* pInfo)
+	static void memory_alloc_site_table_insert_slot(AllocationSiteTable* pTable, uint32 siteIndex)
 	{
-		memory::FillZero(pInfo, sizeof(*pInfo));
+		const AllocationSite& site = pTable->pSites[siteIndex];
+		size_t mask = pTable->slotsCapacity - 1;
+		size_t slot = memory_tracking_hash(site.pFile, site.line) & mask;
+
+		while (pTable->pSlots[slot] != 0)
+			slot = (slot + 1) & mask;
+
+		pTable->pSlots[slot] = siteIndex + 1;
 	}
 
-	AllocationInfo* memory_alloc_info_get_free()
+	static uint32 memory_alloc_site_intern(const char* pFile, size_t line)
 	{
-		for (size_t i = 0; i < MEMORY_MAX_TRACKED_ALLOCATIONS; ++i)
+		AllocationSiteTable* pTable = &s_sites;
+
+		if ((pTable->numSites + 1) * 4 > pTable->slotsCapacity * 3)
+		{
+			size_t newCapacity = pTable->slotsCapacity ? pTable->slotsCapacity * 2 : 1024;
+			free(pTable->pSlots);
+			pTable->pSlots = (uint32*)calloc(newCapacity, sizeof(uint32));
+			pTable->slotsCapacity = newCapacity;
+			iol_assert(pTable->pSlots != nullptr);
+
+			for (uint32 i = 0; i < pTable->numSites; ++i)
+				memory_alloc_site_table_insert_slot(pTable, i);
+		}
+
+		size_t mask = pTable->slotsCapacity - 1;
+		size_t slot = memory_tracking_hash(pFile, line) & mask;
+
+		while (pTable->pSlots[slot] != 0)
+		{
+			const AllocationSite& site = pTable->pSites[pTable->pSlots[slot] - 1];
+
+			if (site.pFile == pFile && site.line == line)
+				return pTable->pSlots[slot] - 1;
+
+			slot = (slot + 1) & mask;
+		}
+
+		if (pTable->numSites == pTable->sitesCapacity)
 		{
-			if (!g_allocations[i].slotUsed)
-				return &g_allocations[i];
+			size_t newCapacity = pTable->sitesCapacity ? pTable->sitesCapacity * 2 : 512;
+			pTable->pSites = (AllocationSite*)realloc(pTable->pSites, newCapacity * sizeof(AllocationSite));
+			pTable->sitesCapacity = newCapacity;
+			iol_assert(pTable->pSites != nullptr);
 		}
 
-		return nullptr;
+		uint32 siteIndex = (uint32)pTable->numSites++;
+		pTable->pSites[siteIndex].pFile = pFile;
+		pTable->pSites[siteIndex].line = line;
+		pTable->pSlots[slot] = siteIndex + 1;
+
+		return siteIndex;
 	}
 
-	AllocationInfo* memory_alloc_info_get(void* pMemory)
+	static void memory_alloc_table_insert(AllocationTable* pTable, const AllocationInfo& info)
 	{
-		if (pMemory == nullptr)
-			return nullptr;
+		size_t mask = pTable->capacity - 1;
+		size_t slot = memory_tracking_hash(info.pMemory, 0) & mask;
+
+		while (pTable->pSlots[slot].pMemory != nullptr)
+			slot = (slot + 1) & mask;
+
+		pTable->pSlots[slot] = info;
+	}
+
+	static void memory_alloc_table_grow(AllocationTable* pTable)
+	{
+		AllocationInfo* pOldSlots = pTable->pSlots;
+		size_t oldCapacity = pTable->capacity;
 
-		for (size_t i = 0; i < MEMORY_MAX_TRACKED_ALLOCATIONS; ++i)
+		pTable->capacity = oldCapacity ? oldCapacity * 2 : MEMORY_TRACKING_INITIAL_CAPACITY;
+		pTable->pSlots = (AllocationInfo*)calloc(pTable->capacity, sizeof(AllocationInfo));
+		iol_assert(pTable->pSlots != nullptr);
+
+		for (size_t i = 0; i < oldCapacity; ++i)
 		{
-			if (g_allocations[i].pMemory == pMemory)
-				return &g_allocations[i];
+			if (pOldSlots[i].pMemory != nullptr)
+				memory_alloc_table_insert(pTable, pOldSlots[i]);
 		}
 
-		return nullptr;
+		free(pOldSlots);
 	}
 
-	size_t memory_alloc_info_get_all(AllocationInfo* pOutAllocations, size_t outMaxAllocations)
+	static bool memory_alloc_table_remove(AllocationTable* pTable, void* pMemory)
 	{
-		size_t outIndex = 0;
-		size_t maxCount = core::Min<size_t>(outMaxAllocations, MEMORY_MAX_TRACKED_ALLOCATIONS);
+		if (pTable->count == 0)
+			return false;
+
+		size_t mask = pTable->capacity - 1;
+		size_t slot = memory_tracking_hash(pMemory, 0) & mask;
 
-		for (size_t i = 0; i < maxCount; ++i)
+		while (pTable->pSlots[slot].pMemory != pMemory)
 		{
-			if (g_allocations[i].slotUsed == true)
+			if (pTable->pSlots[slot].pMemory == nullptr)
+				return false;
+
+			slot = (slot + 1) & mask;
+		}
+
+		// Backward shift deletion, keeps probe sequences intact without tombstones
+		size_t hole = slot;
+		size_t next = (hole + 1) & mask;
+
+		while (pTable->pSlots[next].pMemory != nullptr)
+		{
+			size_t home = memory_tracking_hash(pTable->pSlots[next].pMemory, 0) & mask;
+
+			if (((next - home) & mask) >= ((next - hole) & mask))
 			{
-				if (outIndex < maxCount)
-				{
-					pOutAllocations[outIndex++] = g_allocations[i];
-				}
-				else
-				{
-					return ++outIndex;
-				}
+				pTable->pSlots[hole] = pTable->pSlots[next];
+				hole = next;
 			}
+
+			next = (next + 1) & mask;
 		}
 
-		return outIndex;
+		pTable->pSlots[hole].pMemory = nullptr;
+		pTable->count--;
+
+		return true;
 	}
 
 	void memory_alloc_info_add(const char* pFile, size_t line, void* pMemory, size_t size)
 	{
-		//iol::outputDebugString("allocation: file: %s | line: %d\n", pFunction, pFile, line);
+		std::lock_guard<std::mutex> lock(s_trackingMutex);
+
+		AllocationTable* pTable = &s_allocations;
 
-		AllocationInfo* pAllocationInfo = memory_alloc_info_get_free();
+		if ((pTable->count + 1) * 4 > pTable->capacity * 3)
+			memory_alloc_table_grow(pTable);
 
-		// Increase Memory_MaxTrackedAllocations if you hit this
-		iol_assert(pAllocationInfo);
+		AllocationInfo info;
+		info.pMemory = pMemory;
+		info.size = size;
+		info.siteIndex = memory_alloc_site_intern(pFile, line);
 
-		if (pAllocationInfo != nullptr)
-			memory_alloc_info_set(pAllocationInfo, pFile, line, pMemory, size);
+		memory_alloc_table_insert(pTable, info);
+		pTable->count++;
 	}
 
 	void memory_alloc_info_remove(const char* pFile, size_t line, void* pMemory)
 	{
-		//iol::outputDebugString("deallocation: file: %s | line: %d\n", pFunction, pFile, line);
+		// Leaks are reported by their allocation site, the freeing site is not needed
+		iol_use(pFile);
+		iol_use(line);
 
-		AllocationInfo* pAllocationInfo = memory_alloc_info_get(pMemory);
+		if (pMemory == nullptr)
+			return;
 
-		if (pAllocationInfo != nullptr)
-		{
-			memory_alloc_info_clear(pAllocationInfo);
-		}
+		std::lock_guard<std::mutex> lock(s_trackingMutex);
+		memory_alloc_table_remove(&s_allocations, pMemory);
+	}
+
+	size_t memory_alloc_info_get_count()
+	{
+		std::lock_guard<std::mutex> lock(s_trackingMutex);
+		return s_allocations.count;
 	}
 
 	void* memory_alloc_helper(const char* pFile, size_t line, size_t size)
@@ -132,14 +339,50 @@ namespace iol
 		memory_free(pMemory);
 	}
 
+	void* memory_realloc_helper(const char* pFile, size_t line, void* pMemory, size_t newSize)
+	{
+		memory_alloc_info_remove(pFile, line, pMemory);
+		void* pNewMemory = memory_realloc(pMemory, newSize);
+		memory_alloc_info_add(pFile, line, pNewMemory, newSize);
+		return pNewMemory;
+	}
+
+	void* memory_alloc_aligned_helper(const char* pFile, size_t line, size_t size, size_t alignment)
+	{
+		void* pMemory = memory_allocate_aligned(size, alignment);
+		memory_alloc_info_add(pFile, line, pMemory, size);
+		return pMemory;
+	}
+
+	void memory_free_aligned_helper(const char* pFile, size_t line, void* pMemory)
+	{
+		memory_alloc_info_remove(pFile, line, pMemory);
+		memory_free_aligned(pMemory);
+	}
+
+	void* memory_realloc_aligned_helper(const char* pFile, size_t line, void* pMemory, size_t newSize, size_t alignment)
+	{
+		memory_alloc_info_remove(pFile, line, pMemory);
+		void* pNewMemory = memory_realloc_aligned(pMemory, newSize, alignment);
+		memory_alloc_info_add(pFile, line, pNewMemory, newSize);
+		return pNewMemory;
+	}
+
 	void memory::LogAllocations()
 	{
-		static AllocationInfo s_allocationInfos[MEMORY_MAX_TRACKED_ALLOCATIONS];
-		size_t numAllocations = memory_alloc_info_get_all(s_allocationInfos, iol_countof(s_allocationInfos));
+		std::lock_guard<std::mutex> lock(s_trackingMutex);
+
+		const AllocationTable* pTable = &s_allocations;
 
-		for (size_t i = 0; i < numAllocations; ++i)
+		for (size_t i = 0; i < pTable->capacity; ++i)
 		{
-			iol_log_raw_error("[memory] %s | address: %p | size: %zu", s_allocationInfos[i].fileLineString, s_allocationInfos[i].pMemory, s_allocationInfos[i].size);
+			const AllocationInfo& info = pTable->pSlots[i];
+
+			if (info.pMemory == nullptr)
+				continue;
+
+			const AllocationSite& site = s_sites.pSites[info.siteIndex];
+			iol_log_raw_error("[memory] [%s:%zu] | address: %p | size: %zu", site.pFile, site.line, info.pMemory, info.size);
 		}
 	}
 
@@ -187,4 +430,412 @@ namespace iol
 
 		return memcmp(pFirst, pSecond, size) == 0;
 	}
+
+	void* HeapAllocator::Allocate(size_t size, size_t alignment)
+	{
+		return iol_alloc_raw_aligned(size, alignment);
+	}
+
+	void* HeapAllocator::Reallocate(void* pMemory, size_t oldSize, size_t newSize, size_t alignment)
+	{
+		iol_use(oldSize);
+		return iol_realloc_aligned(pMemory, newSize, alignment);
+	}
+
+	void HeapAllocator::Free(void* pMemory)
+	{
+		iol_free_aligned(pMemory);
+	}
+
+	LinearAllocator::LinearAllocator()
+	{
+		m_pBackingAllocator = nullptr;
+		m_pBuffer = nullptr;
+		m_capacity = 0;
+		m_offset = 0;
+		m_lastOffset = 0;
+		m_peakSize = 0;
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		Destroy();
+	}
+
+	void LinearAllocator::Create(size_t capacity, Allocator* pBackingAllocator)
+	{
+		iol_assert(m_pBuffer == nullptr);
+		iol_assert(capacity > 0);
+
+		if (pBackingAllocator != nullptr)
+			m_pBuffer = (uint8*)pBackingAllocator->Allocate(capacity, MEMORY_ALIGNMENT_DEFAULT);
+		else
+			m_pBuffer = (uint8*)iol_alloc_raw(capacity);
+
+		m_pBackingAllocator = pBackingAllocator;
+		m_capacity = capacity;
+		m_offset = 0;
+		m_lastOffset = 0;
+		m_peakSize = 0;
+	}
+
+	void LinearAllocator::Destroy()
+	{
+		if (m_pBuffer != nullptr)
+		{
+			if (m_pBackingAllocator != nullptr)
+				m_pBackingAllocator->Free(m_pBuffer);
+			else
+				iol_free(m_pBuffer);
+
+			m_pBuffer = nullptr;
+		}
+
+		m_pBackingAllocator = nullptr;
+		m_capacity = 0;
+		m_offset = 0;
+		m_lastOffset = 0;
+	}
+
+	void* LinearAllocator::Allocate(size_t size, size_t alignment)
+	{
+		iol_assert(m_pBuffer != nullptr);
+		iol_assert(size > 0);
+
+		uintptr_t start = (uintptr_t)m_pBuffer;
+		size_t offset = core::Align(start + m_offset, alignment) - start;
+
+		if (offset + size > m_capacity)
+		{
+			iol_log_error("LinearAllocator out of memory! requested: %zu | used: %zu | capacity: %zu", size, m_offset, m_capacity);
+			iol_assert(false);
+			return nullptr;
+		}
+
+		m_lastOffset = offset;
+		m_offset = offset + size;
+		m_peakSize = core::Max(m_peakSize, m_offset);
+
+		return m_pBuffer + offset;
+	}
+
+	void* LinearAllocator::Reallocate(void* pMemory, size_t oldSize, size_t newSize, size_t alignment)
+	{
+		if (pMemory == nullptr)
+			return Allocate(newSize, alignment);
+
+		iol_assert(newSize > 0);
+
+		// The most recent allocation can grow or shrink in place
+		if ((uint8*)pMemory == m_pBuffer + m_lastOffset && ((uintptr_t)pMemory & (alignment - 1)) == 0)
+		{
+			if (m_lastOffset + newSize > m_capacity)
+			{
+				iol_log_error("LinearAllocator out of memory! requested: %zu | used: %zu | capacity: %zu", newSize, m_offset, m_capacity);
+				iol_assert(false);
+				return nullptr;
+			}
+
+			m_offset = m_lastOffset + newSize;
+			m_peakSize = core::Max(m_peakSize, m_offset);
+			return pMemory;
+		}
+
+		void* pNewMemory = Allocate(newSize, alignment);
+
+		if (pNewMemory != nullptr)
+			memory::Copy(pNewMemory, core::Min(oldSize, newSize), pMemory);
+
+		return pNewMemory;
+	}
+
+	void LinearAllocator::Free(void* pMemory)
+	{
+		// Only the most recent allocation can be given back, everything else is released by Reset()
+		if (pMemory != nullptr && (uint8*)pMemory == m_pBuffer + m_lastOffset)
+			m_offset = m_lastOffset;
+	}
+
+	void LinearAllocator::Reset()
+	{
+#ifdef IOL_DEBUG
+		// Make use of stale allocations easy to spot
+		if (m_offset > 0)
+			memory::Fill(m_pBuffer, m_offset, 0xCD);
+#endif
+
+		m_offset = 0;
+		m_lastOffset = 0;
+	}
+
+	PoolAllocator::PoolAllocator()
+	{
+		m_pBackingAllocator = nullptr;
+		m_pFreeList = nullptr;
+		m_pChunks = nullptr;
+		m_pCursor = nullptr;
+		m_pCursorEnd = nullptr;
+		m_blockSize = 0;
+		m_alignment = 0;
+		m_blocksPerChunk = 0;
+		m_numAllocatedBlocks = 0;
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		Destroy();
+	}
+
+	void PoolAllocator::Create(size_t blockSize, size_t initialBlocksPerChunk, size_t alignment, Allocator* pBackingAllocator)
+	{
+		iol_assert(m_pChunks == nullptr);
+		iol_assert(blockSize > 0);
+		// Every free block stores the pointer to the next free block
+		m_pBackingAllocator = pBackingAllocator;
+		m_blockSize = core::Align(core::Max(blockSize, sizeof(void*)), alignment);
+		m_alignment = alignment;
+		m_blocksPerChunk = core::Clamp<size_t>(initialBlocksPerChunk, 1, MEMORY_POOL_MAX_BLOCKS_PER_CHUNK);
+		m_numAllocatedBlocks = 0;
+	}
+
+	void PoolAllocator::Destroy()
+	{
+		Chunk* pChunk = m_pChunks;
+
+		while (pChunk)
+		{
+			Chunk* pNext = pChunk->pNext;
+
+			if (m_pBackingAllocator != nullptr)
+				m_pBackingAllocator->Free(pChunk);
+			else
+				iol_free_aligned(pChunk);
+
+			pChunk = pNext;
+		}
+
+		m_pFreeList = nullptr;
+		m_pChunks = nullptr;
+		m_pCursor = nullptr;
+		m_pCursorEnd = nullptr;
+		m_numAllocatedBlocks = 0;
+	}
+
+	void PoolAllocator::AllocateChunk()
+	{
+		size_t headerSize = core::Align(sizeof(Chunk), m_alignment);
+		size_t chunkSize = headerSize + m_blockSize * m_blocksPerChunk;
+		Chunk* pChunk;
+
+		if (m_pBackingAllocator != nullptr)
+			pChunk = (Chunk*)m_pBackingAllocator->Allocate(chunkSize, m_alignment);
+		else
+			pChunk = (Chunk*)iol_alloc_raw_aligned(chunkSize, m_alignment);
+
+		iol_assert(pChunk != nullptr);
+		pChunk->pNext = m_pChunks;
+		m_pChunks = pChunk;
+
+		m_pCursor = (uint8*)pChunk + headerSize;
+		m_pCursorEnd = m_pCursor + m_blockSize * m_blocksPerChunk;
+
+		m_blocksPerChunk = core::Min<size_t>(m_blocksPerChunk * 2, MEMORY_POOL_MAX_BLOCKS_PER_CHUNK);
+	}
+
+	void* PoolAllocator::Allocate()
+	{
+		iol_assert(m_blockSize > 0);
+
+		void* pBlock;
+
+		if (m_pFreeList != nullptr)
+		{
+			pBlock = m_pFreeList;
+			m_pFreeList = *(void**)pBlock;
+		}
+		else
+		{
+			if (m_pCursor == m_pCursorEnd)
+				AllocateChunk();
+
+			pBlock = m_pCursor;
+			m_pCursor += m_blockSize;
+		}
+
+		m_numAllocatedBlocks++;
+
+		return pBlock;
+	}
+
+	void* PoolAllocator::Allocate(size_t size, size_t alignment)
+	{
+		iol_assert(size <= m_blockSize);
+		iol_assert(alignment <= m_alignment);
+		iol_use(size);
+		iol_use(alignment);
+
+		return Allocate();
+	}
+
+	void* PoolAllocator::Reallocate(void* pMemory, size_t oldSize, size_t newSize, size_t alignment)
+	{
+		iol_use(oldSize);
+
+		// Every block has the same size, the block either fits or the request is invalid
+		if (pMemory == nullptr)
+			return Allocate(newSize, alignment);
+
+		iol_assert(newSize <= m_blockSize);
+		iol_assert(alignment <= m_alignment);
+		iol_use(newSize);
+		iol_use(alignment);
+
+		return pMemory;
+	}
+
+	void PoolAllocator::Free(void* pBlock)
+	{
+		iol_assert(pBlock != nullptr);
+		iol_assert(m_numAllocatedBlocks > 0);
+
+		*(void**)pBlock = m_pFreeList;
+		m_pFreeList = pBlock;
+		m_numAllocatedBlocks--;
+	}
+
+	static HeapAllocator s_heapAllocator;
+	static LinearAllocator s_frameAllocator;
+
+	void memory::CreateFrameAllocator(size_t capacity)
+	{
+		s_frameAllocator.Create(capacity);
+	}
+
+	void memory::DestroyFrameAllocator()
+	{
+		s_frameAllocator.Destroy();
+	}
+
+	void memory::ResetFrameAllocator()
+	{
+		s_frameAllocator.Reset();
+	}
+
+	LinearAllocator* memory::GetFrameAllocator()
+	{
+		return &s_frameAllocator;
+	}
+
+	HeapAllocator* memory::GetHeapAllocator()
+	{
+		return &s_heapAllocator;
+	}
+
+	size_t memory::GetPageSize()
+	{
+		static size_t s_pageSize = 0;
+
+		if (s_pageSize == 0)
+		{
+#ifdef IOL_PLATFORM_WINDOWS
+			SYSTEM_INFO systemInfo;
+			GetSystemInfo(&systemInfo);
+			s_pageSize = systemInfo.dwPageSize;
+#elif defined(IOL_PLATFORM_LINUX)
+			s_pageSize = (size_t)sysconf(_SC_PAGESIZE);
+#else
+#error not implemented
+#endif
+		}
+
+		return s_pageSize;
+	}
+
+	void* memory::ReserveVirtual(size_t size)
+	{
+		iol_assert(size > 0);
+
+#ifdef IOL_PLATFORM_WINDOWS
+		void* pAddress = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#elif defined(IOL_PLATFORM_LINUX)
+		void* pAddress = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+		if (pAddress == MAP_FAILED)
+			pAddress = nullptr;
+#else
+#error not implemented
+#endif
+
+		if (pAddress == nullptr)
+		{
+			iol_log_error("failed to reserve %zu bytes of address space", size);
+		}
+
+		return pAddress;
+	}
+
+	void memory::ReleaseVirtual(void* pAddress, size_t size)
+	{
+		iol_assert(pAddress != nullptr);
+
+#ifdef IOL_PLATFORM_WINDOWS
+		iol_use(size);
+		VirtualFree(pAddress, 0, MEM_RELEASE);
+#elif defined(IOL_PLATFORM_LINUX)
+		munmap(pAddress, size);
+#else
+#error not implemented
+#endif
+	}
+
+	bool memory::CommitVirtual(void* pAddress, size_t size)
+	{
+		iol_assert(pAddress != nullptr);
+		iol_assert((uintptr_t)pAddress % GetPageSize() == 0);
+
+#ifdef IOL_PLATFORM_WINDOWS
+		bool success = VirtualAlloc(pAddress, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#elif defined(IOL_PLATFORM_LINUX)
+		bool success = mprotect(pAddress, size, PROT_READ | PROT_WRITE) == 0;
+#else
+#error not implemented
+#endif
+
+		if (!success)
+		{
+			iol_log_error("failed to commit %zu bytes at %p", size, pAddress);
+		}
+
+		return success;
+	}
+
+	void memory::DecommitVirtual(void* pAddress, size_t size)
+	{
+		iol_assert(pAddress != nullptr);
+		iol_assert((uintptr_t)pAddress % GetPageSize() == 0);
+
+#ifdef IOL_PLATFORM_WINDOWS
+		VirtualFree(pAddress, size, MEM_DECOMMIT);
+#elif defined(IOL_PLATFORM_LINUX)
+		// Drop the physical pages first, the range reads as zero when it is committed again
+		madvise(pAddress, size, MADV_DONTNEED);
+		mprotect(pAddress, size, PROT_NONE);
+#else
+#error not implemented
+#endif
+	}
+
+	void memory::AdviseHugePages(void* pAddress, size_t size)
+	{
+		iol_assert(pAddress != nullptr);
+
+#if defined(IOL_PLATFORM_LINUX) && defined(MADV_HUGEPAGE)
+		// Only a hint, transparent huge pages may be disabled on the system
+		madvise(pAddress, size, MADV_HUGEPAGE);
+#else
+		// Large pages on Windows need the SeLockMemoryPrivilege and have to be requested at reservation time
+		iol_use(pAddress);
+		iol_use(size);
+#endif
+	}
 }
\ No newline at end of file
@@ -0,0 +1,14 @@
+#include "iol_sort.h"
+
+namespace iol
+{
+	void sort::RadixSort(Array<uint32>& array, Allocator* pTempAllocator)
+	{
+		RadixSort(array.pData, array.count, [](uint32 key) { return key; }, pTempAllocator);
+	}
+
+	void sort::RadixSort(Array<uint64>& array, Allocator* pTempAllocator)
+	{
+		RadixSort(array.pData, array.count, [](uint64 key) { return key; }, pTempAllocator);
+	}
+}
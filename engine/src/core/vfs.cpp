@@ -0,0 +1,661 @@
+#include "iol_vfs.h"
+#include "iol_array.h"
+#include "iol_debug.h"
+#include "iol_hash.h"
+#include "iol_memory.h"
+#include "iol_sort.h"
+#include "iol_string.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef IOL_PLATFORM_WINDOWS
+#include "platform_internal.h"
+#elif defined(IOL_PLATFORM_LINUX)
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#define VFS_MAX_PATH 1024
+
+namespace iol
+{
+	enum class VfsMountType
+	{
+		Directory,
+		Archive,
+	};
+
+	struct VfsMount
+	{
+		VfsMountType type;
+		char* pMountPoint;
+		size_t mountPointLength;
+
+		// Directory
+		char* pDirectoryPath;
+
+		// Archive
+		FileMapping archive;
+		const VfsArchiveEntry* pEntries;
+		uint32 numEntries;
+		const char* pStrings;
+	};
+
+	struct VfsSystemData
+	{
+		Array<VfsMount> mounts;
+	};
+
+	// Where a path was found, either an archive entry or a file on disk
+	struct VfsLocation
+	{
+		const VfsMount* pMount;
+		const VfsArchiveEntry* pEntry;
+		char filePath[VFS_MAX_PATH];
+	};
+
+	static VfsSystemData* s_vfs = nullptr;
+
+	static bool vfs_normalize_path(const char* pPath, char* pOutPath, size_t capacity)
+	{
+		while (pPath[0] == '.' && (pPath[1] == '/' || pPath[1] == '\\'))
+			pPath += 2;
+
+		size_t length = string::GetLength(pPath);
+
+		if (length >= capacity)
+		{
+			iol_log_error("vfs path too long: '%s'", pPath);
+			return false;
+		}
+
+		for (size_t i = 0; i <= length; i++)
+			pOutPath[i] = pPath[i] == '\\' ? '/' : pPath[i];
+
+		// No trailing separator, mount points and directories are joined with a single '/'
+		while (length > 0 && pOutPath[length - 1] == '/')
+			pOutPath[--length] = '\0';
+
+		return true;
+	}
+
+	// Returns the path relative to the mount point, or nullptr if the mount doesn't serve the path
+	static const char* vfs_get_relative_path(const VfsMount& mount, const char* pPath)
+	{
+		if (mount.mountPointLength == 0)
+			return pPath;
+
+		if (strncmp(pPath, mount.pMountPoint, mount.mountPointLength) != 0 || pPath[mount.mountPointLength] != '/')
+			return nullptr;
+
+		return pPath + mount.mountPointLength + 1;
+	}
+
+	static const VfsArchiveEntry* vfs_find_entry(const VfsMount& mount, const char* pRelativePath)
+	{
+		size_t length = string::GetLength(pRelativePath);
+		uint64 hash = hash::String(pRelativePath, length);
+
+		// Lower bound of the hash, entries with colliding hashes are adjacent
+		size_t lo = 0;
+		size_t hi = mount.numEntries;
+
+		while (lo < hi)
+		{
+			size_t mid = (lo + hi) / 2;
+
+			if (mount.pEntries[mid].pathHash < hash)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		for (size_t i = lo; i < mount.numEntries && mount.pEntries[i].pathHash == hash; i++)
+		{
+			const VfsArchiveEntry& entry = mount.pEntries[i];
+
+			if (entry.pathLength == length && memcmp(mount.pStrings + entry.pathOffset, pRelativePath, length) == 0)
+				return &entry;
+		}
+
+		return nullptr;
+	}
+
+	static bool vfs_resolve(const char* pPath, VfsLocation* pOutLocation)
+	{
+		pOutLocation->pMount = nullptr;
+		pOutLocation->pEntry = nullptr;
+
+		if (!vfs_normalize_path(pPath, pOutLocation->filePath, sizeof(pOutLocation->filePath)))
+			return false;
+
+		if (s_vfs == nullptr)
+			return true;
+
+		for (size_t i = s_vfs->mounts.count; i-- > 0;)
+		{
+			const VfsMount& mount = s_vfs->mounts[i];
+			const char* pRelativePath = vfs_get_relative_path(mount, pOutLocation->filePath);
+
+			if (pRelativePath == nullptr)
+				continue;
+
+			if (mount.type == VfsMountType::Archive)
+			{
+				const VfsArchiveEntry* pEntry = vfs_find_entry(mount, pRelativePath);
+
+				if (pEntry != nullptr)
+				{
+					pOutLocation->pMount = &mount;
+					pOutLocation->pEntry = pEntry;
+					return true;
+				}
+			}
+			else
+			{
+				char filePath[VFS_MAX_PATH];
+				int length = snprintf(filePath, sizeof(filePath), "%s/%s", mount.pDirectoryPath, pRelativePath);
+
+				if (length > 0 && (size_t)length < sizeof(filePath) && file::Exists(filePath))
+				{
+					pOutLocation->pMount = &mount;
+					string::Copy(pOutLocation->filePath, filePath, sizeof(pOutLocation->filePath));
+					return true;
+				}
+			}
+		}
+
+		// Not in any mount, use the path as it is
+		return true;
+	}
+
+	static VfsMount* vfs_add_mount(VfsMountType type, const char* pMountPoint)
+	{
+		iol_assert(s_vfs != nullptr);
+
+		char mountPoint[VFS_MAX_PATH];
+
+		if (!vfs_normalize_path(pMountPoint != nullptr ? pMountPoint : "", mountPoint, sizeof(mountPoint)))
+			return nullptr;
+
+		VfsMount& mount = s_vfs->mounts.PushBack();
+		memory::FillZero(&mount, sizeof(VfsMount));
+		mount.type = type;
+		mount.pMountPoint = string::CopyAlloc(mountPoint);
+		mount.mountPointLength = string::GetLength(mountPoint);
+
+		return &mount;
+	}
+
+	static bool vfs_validate_archive(const FileMapping& archive, const char* pArchivePath)
+	{
+		const VfsArchiveHeader* pHeader = (const VfsArchiveHeader*)archive.pData;
+
+		if (archive.size < sizeof(VfsArchiveHeader) || pHeader->magic != VFS_ARCHIVE_MAGIC)
+		{
+			iol_log_error("not a vfs archive: '%s'", pArchivePath);
+			return false;
+		}
+
+		if (pHeader->version != VFS_ARCHIVE_VERSION)
+		{
+			iol_log_error("vfs archive '%s' has version %u, expected %u", pArchivePath, pHeader->version, VFS_ARCHIVE_VERSION);
+			return false;
+		}
+
+		uint64 entriesEnd = sizeof(VfsArchiveHeader) + (uint64)pHeader->numEntries * sizeof(VfsArchiveEntry);
+
+		if (entriesEnd > archive.size || pHeader->stringsOffset < entriesEnd || pHeader->stringsOffset + pHeader->stringsSize > archive.size)
+		{
+			iol_log_error("vfs archive is truncated: '%s'", pArchivePath);
+			return false;
+		}
+
+		const VfsArchiveEntry* pEntries = (const VfsArchiveEntry*)(archive.pData + sizeof(VfsArchiveHeader));
+
+		for (uint32 i = 0; i < pHeader->numEntries; i++)
+		{
+			const VfsArchiveEntry& entry = pEntries[i];
+
+			if (entry.offset + entry.size > archive.size || (uint64)entry.pathOffset + entry.pathLength > pHeader->stringsSize)
+			{
+				iol_log_error("vfs archive is truncated: '%s'", pArchivePath);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void vfs::CreateSystem()
+	{
+		iol_assert(s_vfs == nullptr);
+
+		s_vfs = iol_new(VfsSystemData);
+		s_vfs->mounts.CreateGrowable(4);
+	}
+
+	void vfs::DestroySystem()
+	{
+		iol_assert(s_vfs != nullptr);
+
+		for (size_t i = 0; i < s_vfs->mounts.count; i++)
+		{
+			VfsMount& mount = s_vfs->mounts[i];
+
+			if (mount.type == VfsMountType::Archive)
+				file::Unmap(&mount.archive);
+			else
+				iol_free(mount.pDirectoryPath);
+
+			iol_free(mount.pMountPoint);
+		}
+
+		s_vfs->mounts.Destroy();
+		iol_delete(s_vfs);
+	}
+
+	bool vfs::MountArchive(const char* pArchivePath, const char* pMountPoint)
+	{
+		iol_assert(pArchivePath != nullptr);
+
+		// Entries are read in random order, no read ahead
+		FileMapping archive;
+
+		if (!file::Map(pArchivePath, &archive, FileMapFlags_None))
+			return false;
+
+		if (!vfs_validate_archive(archive, pArchivePath))
+		{
+			file::Unmap(&archive);
+			return false;
+		}
+
+		VfsMount* pMount = vfs_add_mount(VfsMountType::Archive, pMountPoint);
+
+		if (pMount == nullptr)
+		{
+			file::Unmap(&archive);
+			return false;
+		}
+
+		const VfsArchiveHeader* pHeader = (const VfsArchiveHeader*)archive.pData;
+		pMount->archive = archive;
+		pMount->pEntries = (const VfsArchiveEntry*)(archive.pData + sizeof(VfsArchiveHeader));
+		pMount->numEntries = pHeader->numEntries;
+		pMount->pStrings = (const char*)(archive.pData + pHeader->stringsOffset);
+
+		return true;
+	}
+
+	bool vfs::MountDirectory(const char* pDirectoryPath, const char* pMountPoint)
+	{
+		iol_assert(pDirectoryPath != nullptr);
+
+		char directoryPath[VFS_MAX_PATH];
+
+		if (!vfs_normalize_path(pDirectoryPath, directoryPath, sizeof(directoryPath)))
+			return false;
+
+		if (!file::Exists(directoryPath))
+		{
+			iol_log_error("failed to mount directory: '%s'", pDirectoryPath);
+			return false;
+		}
+
+		VfsMount* pMount = vfs_add_mount(VfsMountType::Directory, pMountPoint);
+
+		if (pMount == nullptr)
+			return false;
+
+		pMount->pDirectoryPath = string::CopyAlloc(directoryPath);
+
+		return true;
+	}
+
+	bool vfs::Exists(const char* pPath)
+	{
+		VfsLocation location;
+
+		if (!vfs_resolve(pPath, &location))
+			return false;
+
+		return location.pEntry != nullptr || file::Exists(location.filePath);
+	}
+
+	bool vfs::Map(const char* pPath, FileMapping* pOutMapping)
+	{
+		iol_assert(pPath != nullptr);
+		iol_assert(pOutMapping != nullptr);
+
+		pOutMapping->pData = nullptr;
+		pOutMapping->size = 0;
+		pOutMapping->pHandle = nullptr;
+
+		VfsLocation location;
+
+		if (!vfs_resolve(pPath, &location))
+			return false;
+
+		if (location.pEntry == nullptr)
+			return file::Map(location.filePath, pOutMapping);
+
+		// Same contract as file::Map, empty files can't be mapped
+		if (location.pEntry->size == 0)
+			return false;
+
+		pOutMapping->pData = location.pMount->archive.pData + location.pEntry->offset;
+		pOutMapping->size = (size_t)location.pEntry->size;
+
+		return true;
+	}
+
+	void vfs::Unmap(FileMapping* pMapping)
+	{
+		iol_assert(pMapping != nullptr);
+
+		if (pMapping->pData == nullptr)
+			return;
+
+		// Views into an archive stay mapped until the archive is unmounted
+		if (s_vfs != nullptr)
+		{
+			for (size_t i = 0; i < s_vfs->mounts.count; i++)
+			{
+				const FileMapping& archive = s_vfs->mounts[i].archive;
+
+				if (pMapping->pData >= archive.pData && pMapping->pData < archive.pData + archive.size)
+				{
+					pMapping->pData = nullptr;
+					pMapping->size = 0;
+					return;
+				}
+			}
+		}
+
+		file::Unmap(pMapping);
+	}
+
+	char* vfs::ReadAllText(const char* pPath, size_t* pOutFileSize)
+	{
+		if (pOutFileSize)
+			*pOutFileSize = 0u;
+
+		VfsLocation location;
+
+		if (!vfs_resolve(pPath, &location))
+			return nullptr;
+
+		if (location.pEntry == nullptr)
+			return file::ReadAllText(location.filePath, pOutFileSize, 0u);
+
+		size_t size = (size_t)location.pEntry->size;
+		char* pBuffer = (char*)iol_alloc_raw(size + 1);
+
+		if (size > 0)
+			memory::Copy(pBuffer, size, location.pMount->archive.pData + location.pEntry->offset);
+
+		pBuffer[size] = '\0';
+
+		if (pOutFileSize)
+			*pOutFileSize = size;
+
+		return pBuffer;
+	}
+
+	//-------------------------------------
+	// Packer
+	//-------------------------------------
+
+	struct VfsPackEntry
+	{
+		VfsArchiveEntry entry;
+		char* pRelativePath;
+	};
+
+	// Joins two path parts with a '/', an empty part is left out. Fails instead of truncating the path.
+	static bool vfs_join_path(char* pOutPath, size_t capacity, const char* pFirst, const char* pSecond)
+	{
+		const char* pFormat = pFirst[0] != '\0' && pSecond[0] != '\0' ? "%s/%s" : "%s%s";
+		int length = snprintf(pOutPath, capacity, pFormat, pFirst, pSecond);
+
+		if (length < 0 || (size_t)length >= capacity)
+		{
+			iol_log_error("path '%s/%s' is longer than %zu characters", pFirst, pSecond, capacity - 1);
+			return false;
+		}
+
+		return true;
+	}
+
+	// Appends the paths of all files below the directory, relative to the packed root directory
+	static bool vfs_collect_files(const char* pDirectoryPath, const char* pRelativePath, Array<char*>& outPaths)
+	{
+		char directoryPath[VFS_MAX_PATH];
+
+		if (!vfs_join_path(directoryPath, sizeof(directoryPath), pDirectoryPath, pRelativePath))
+			return false;
+
+		char relativePath[VFS_MAX_PATH];
+		bool success = true;
+
+#ifdef IOL_PLATFORM_WINDOWS
+		char searchPath[VFS_MAX_PATH];
+
+		if (!vfs_join_path(searchPath, sizeof(searchPath), directoryPath, "*"))
+			return false;
+
+		WIN32_FIND_DATAA findData;
+		HANDLE findHandle = FindFirstFileA(searchPath, &findData);
+
+		if (findHandle == INVALID_HANDLE_VALUE)
+			return true;
+
+		do
+		{
+			const char* pName = findData.cFileName;
+
+			if (string::Compare(pName, ".") || string::Compare(pName, ".."))
+				continue;
+
+			success = vfs_join_path(relativePath, sizeof(relativePath), pRelativePath, pName);
+
+			if (!success)
+				break;
+
+			if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+				success = vfs_collect_files(pDirectoryPath, relativePath, outPaths);
+			else
+				outPaths.PushBack(string::CopyAlloc(relativePath));
+		} while (success && FindNextFileA(findHandle, &findData));
+
+		FindClose(findHandle);
+#elif defined(IOL_PLATFORM_LINUX)
+		DIR* pDirectory = opendir(directoryPath);
+
+		if (pDirectory == nullptr)
+			return true;
+
+		while (dirent* pDirectoryEntry = readdir(pDirectory))
+		{
+			const char* pName = pDirectoryEntry->d_name;
+
+			if (strcmp(pName, ".") == 0 || strcmp(pName, "..") == 0)
+				continue;
+
+			char filePath[VFS_MAX_PATH];
+			success = vfs_join_path(relativePath, sizeof(relativePath), pRelativePath, pName) &&
+				vfs_join_path(filePath, sizeof(filePath), pDirectoryPath, relativePath);
+
+			if (!success)
+				break;
+
+			struct stat fileStat;
+
+			if (stat(filePath, &fileStat) != 0)
+				continue;
+
+			if (S_ISDIR(fileStat.st_mode))
+				success = vfs_collect_files(pDirectoryPath, relativePath, outPaths);
+			else if (S_ISREG(fileStat.st_mode))
+				outPaths.PushBack(string::CopyAlloc(relativePath));
+
+			if (!success)
+				break;
+		}
+
+		closedir(pDirectory);
+#else
+#error not implemented
+#endif
+
+		return success;
+	}
+
+	static bool vfs_write_padding(File* pFile, uint64 size)
+	{
+		static const uint8 s_zeros[VFS_ARCHIVE_ALIGNMENT] = {};
+
+		while (size > 0)
+		{
+			size_t chunkSize = (size_t)core::Min<uint64>(size, sizeof(s_zeros));
+
+			if (!file::Write(pFile, s_zeros, chunkSize))
+				return false;
+
+			size -= chunkSize;
+		}
+
+		return true;
+	}
+
+	iol_inline uint64 vfs_align(uint64 value)
+	{
+		return (value + VFS_ARCHIVE_ALIGNMENT - 1) & ~(uint64)(VFS_ARCHIVE_ALIGNMENT - 1);
+	}
+
+	bool vfs::PackDirectory(const char* pDirectoryPath, const char* pArchivePath)
+	{
+		iol_assert(pDirectoryPath != nullptr);
+		iol_assert(pArchivePath != nullptr);
+
+		char directoryPath[VFS_MAX_PATH];
+
+		if (!vfs_normalize_path(pDirectoryPath, directoryPath, sizeof(directoryPath)))
+			return false;
+
+		Array<char*> paths;
+		paths.CreateGrowable(64);
+		bool success = vfs_collect_files(directoryPath, "", paths);
+
+		Array<VfsPackEntry> entries(paths.count > 0 ? paths.count : 1);
+		uint64 stringsSize = 0;
+
+		for (size_t i = 0; i < paths.count && success; i++)
+		{
+			char filePath[VFS_MAX_PATH];
+
+			if (!vfs_join_path(filePath, sizeof(filePath), directoryPath, paths[i]))
+			{
+				success = false;
+				break;
+			}
+
+			File* pFile = file::Open(filePath, FileMode::BinaryRead);
+
+			if (pFile == nullptr)
+			{
+				success = false;
+				break;
+			}
+
+			size_t pathLength = string::GetLength(paths[i]);
+
+			VfsPackEntry& packEntry = entries.PushBack();
+			packEntry.pRelativePath = paths[i];
+			packEntry.entry.pathHash = hash::String(paths[i], pathLength);
+			packEntry.entry.offset = 0;
+			packEntry.entry.size = file::GetSize(pFile);
+			packEntry.entry.pathOffset = (uint32)stringsSize;
+			packEntry.entry.pathLength = (uint32)pathLength;
+			stringsSize += pathLength;
+
+			file::Close(pFile);
+		}
+
+		sort::Sort(entries, [](const VfsPackEntry& a, const VfsPackEntry& b) { return a.entry.pathHash < b.entry.pathHash; });
+
+		VfsArchiveHeader header;
+		header.magic = VFS_ARCHIVE_MAGIC;
+		header.version = VFS_ARCHIVE_VERSION;
+		header.numEntries = (uint32)entries.count;
+		header.alignment = VFS_ARCHIVE_ALIGNMENT;
+		header.stringsOffset = sizeof(VfsArchiveHeader) + sizeof(VfsArchiveEntry) * entries.count;
+		header.stringsSize = stringsSize;
+
+		uint64 offset = vfs_align(header.stringsOffset + stringsSize);
+
+		for (size_t i = 0; i < entries.count; i++)
+		{
+			entries[i].entry.offset = offset;
+			offset = vfs_align(offset + entries[i].entry.size);
+		}
+
+		File* pArchive = success ? file::Open(pArchivePath, FileMode::BinaryWrite) : nullptr;
+		success = pArchive != nullptr;
+
+		if (success)
+		{
+			success = file::Write(pArchive, &header, sizeof(header));
+
+			for (size_t i = 0; i < entries.count && success; i++)
+				success = file::Write(pArchive, &entries[i].entry, sizeof(VfsArchiveEntry));
+
+			// The strings are stored in collection order, the path offsets don't change with the sort
+			for (size_t i = 0; i < paths.count && success; i++)
+				success = file::Write(pArchive, paths[i], string::GetLength(paths[i]));
+
+			uint64 position = header.stringsOffset + stringsSize;
+
+			for (size_t i = 0; i < entries.count && success; i++)
+			{
+				const VfsArchiveEntry& entry = entries[i].entry;
+				success = vfs_write_padding(pArchive, entry.offset - position);
+				position = entry.offset;
+
+				if (!success || entry.size == 0)
+					continue;
+
+				char filePath[VFS_MAX_PATH];
+				success = vfs_join_path(filePath, sizeof(filePath), directoryPath, entries[i].pRelativePath);
+
+				if (!success)
+					continue;
+
+				FileMapping mapping;
+				success = file::Map(filePath, &mapping) && mapping.size == entry.size;
+
+				if (mapping.pData != nullptr)
+				{
+					success = success && file::Write(pArchive, mapping.pData, mapping.size);
+					file::Unmap(&mapping);
+				}
+
+				position += entry.size;
+			}
+
+			file::Close(pArchive);
+		}
+
+		if (!success)
+		{
+			iol_log_error("failed to pack '%s' into '%s'", pDirectoryPath, pArchivePath);
+		}
+
+		for (size_t i = 0; i < paths.count; i++)
+			iol_free(paths[i]);
+
+		return success;
+	}
+}
@@ -18,8 +18,7 @@ namespace iol
 		iol_assert(attributeParams != nullptr);
 		iol_assert(numVertexAttributes > 0);
 
-		layout->numVertexAttributes = numVertexAttributes;
-		layout->vertexAttributes = iol_alloc_array(VertexAttribute, numVertexAttributes);
+		layout->vertexAttributes.Resize(numVertexAttributes);
 
 		size_t highestVertexBufferIndex = 0;
 
@@ -29,10 +28,8 @@ namespace iol
 				highestVertexBufferIndex = attributeParams[i].vertexBufferIndex;
 		}
 
-		layout->numVertexBuffers = highestVertexBufferIndex + 1;
-
-		layout->strides = iol_alloc_array(uint32, layout->numVertexBuffers);
-		memory::FillZero(layout->strides, sizeof(*layout->strides) * layout->numVertexBuffers);
+		layout->strides.Resize(highestVertexBufferIndex + 1);
+		memory::FillZero(layout->strides.pData, sizeof(uint32) * layout->strides.count);
 
 		for (size_t i = 0; i < numVertexAttributes; i++)
 		{
@@ -47,7 +44,7 @@ namespace iol
 
 	void graphics_base::DestroyVertexLayout(VertexLayoutBase* layout)
 	{
-		iol_free(layout->vertexAttributes);
-		iol_free(layout->strides);
+		layout->vertexAttributes.Destroy();
+		layout->strides.Destroy();
 	}
 }
\ No newline at end of file
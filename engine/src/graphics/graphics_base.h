@@ -2,6 +2,10 @@
 #define IOLITE_GRAPHICS_BASE_H
 
 #include "iol_graphics.h"
+#include "iol_small_array.h"
+
+#define VERTEX_LAYOUT_INLINE_ATTRIBUTES 8
+#define VERTEX_LAYOUT_INLINE_VERTEX_BUFFERS 4
 
 namespace iol
 {
@@ -13,10 +17,8 @@ namespace iol
 
 	struct VertexLayoutBase
 	{
-		VertexAttribute* vertexAttributes;
-		size_t numVertexAttributes;
-		uint32* strides; // stride for each vertex buffer
-		size_t numVertexBuffers;
+		SmallArray<VertexAttribute, VERTEX_LAYOUT_INLINE_ATTRIBUTES> vertexAttributes;
+		SmallArray<uint32, VERTEX_LAYOUT_INLINE_VERTEX_BUFFERS> strides; // stride for each vertex buffer
 	};
 
 	namespace graphics_base
@@ -5,8 +5,8 @@ namespace iol
 {
 	struct GraphicsPipelineState
 	{
-		const Shader* pShader;
-		const VertexLayout* pVertexLayout;
+		ShaderHandle shader;
+		VertexLayoutHandle vertexLayout;
 		uint32 primitiveType;
 		uint32 rasterizerFlags;
 		uint32 pipelineFlags;
@@ -19,13 +19,39 @@ namespace iol
 		SDL_GLContext glContext;
 		uint32 screenWidth;
 		uint32 screenHeight;
-		const GraphicsPipelineState* pPipelineState;
+		GraphicsPipelineState pipelineState; // copy of the bound state, the pool may move it
 		BlendMode blendMode;
 		uint32 shaderProgramId;
 		uint32 rasterizerFlags;
 		uint32 pipelineFlags;
+
+		SlotMap<GraphicsPipelineState> pipelineStates;
+		SlotMap<Shader> shaders;
+		SlotMap<VertexLayout> vertexLayouts;
+		SlotMap<VertexBuffer> vertexBuffers;
+		SlotMap<IndexBuffer> indexBuffers;
+		SlotMap<UniformBuffer> uniformBuffers;
+		SlotMap<VertexArray> vertexArrays;
+		SlotMap<Texture> textures;
 	};
 
+	template<typename T>
+	static T* graphics_get_resource(const SlotMap<T>& pool, Handle<T> handle)
+	{
+		T* pResource = pool.Get(handle);
+		iol_assert(pResource != nullptr); // the resource was destroyed or the handle was never created
+		return pResource;
+	}
+
+	template<typename T>
+	static void graphics_check_leaks(const SlotMap<T>& pool, const char* pName)
+	{
+		if (pool.GetCount() > 0)
+		{
+			iol_log_warning("%zu %s not destroyed", pool.GetCount(), pName);
+		}
+	}
+
 	bool GraphicsSystem::Create(const GraphicsSystemParam& param)
 	{
 #ifdef IOL_DEBUG
@@ -122,6 +148,15 @@ namespace iol
 	void GraphicsSystem::Destroy()
 	{
 		event_system::RemoveListener(EventType_WindowResize, GraphicsSystem::HandleEvent, m_data);
+
+		graphics_check_leaks(m_data->pipelineStates, "pipeline states");
+		graphics_check_leaks(m_data->shaders, "shaders");
+		graphics_check_leaks(m_data->vertexLayouts, "vertex layouts");
+		graphics_check_leaks(m_data->vertexBuffers, "vertex buffers");
+		graphics_check_leaks(m_data->indexBuffers, "index buffers");
+		graphics_check_leaks(m_data->uniformBuffers, "uniform buffers");
+		graphics_check_leaks(m_data->vertexArrays, "vertex arrays");
+		graphics_check_leaks(m_data->textures, "textures");
 		
 		ImGui_ImplOpenGL3_Shutdown();
 		ImGui_ImplSDL2_Shutdown();
@@ -163,22 +198,22 @@ namespace iol
 		return m_data->screenWidth / (float)m_data->screenHeight;
 	}
 
-	GraphicsPipelineState* GraphicsSystem::CreatePipelineState(const GraphicsPipeLineStateParam& param)
+	GraphicsPipelineStateHandle GraphicsSystem::CreatePipelineState(const GraphicsPipeLineStateParam& param)
 	{
-		GraphicsPipelineState* state = iol_alloc(GraphicsPipelineState);
-		state->pShader = (Shader*)param.pShader;
-		state->pVertexLayout = (VertexLayout*)param.pVertexLayout;
-		state->primitiveType = gl::ConvertPrimitiveType(param.primitiveType);
-		state->rasterizerFlags = param.rasterizerFlags;
-		state->blendMode = param.blendMode;
-		state->pipelineFlags = param.pipelineFlags;
-
-		return state;
+		GraphicsPipelineState state;
+		state.shader = param.shader;
+		state.vertexLayout = param.vertexLayout;
+		state.primitiveType = gl::ConvertPrimitiveType(param.primitiveType);
+		state.rasterizerFlags = param.rasterizerFlags;
+		state.blendMode = param.blendMode;
+		state.pipelineFlags = param.pipelineFlags;
+
+		return m_data->pipelineStates.Add(state);
 	}
 
-	void GraphicsSystem::DestroyPipelineState(GraphicsPipelineState* state)
+	void GraphicsSystem::DestroyPipelineState(GraphicsPipelineStateHandle pipelineState)
 	{
-		iol_free(state);
+		iol_verify(m_data->pipelineStates.Remove(pipelineState));
 	}
 
 #ifdef IOL_DEBUG
@@ -370,168 +405,167 @@ namespace iol
 		}
 	}
 
-	VertexBuffer* GraphicsSystem::CreateVertexBuffer(const void* pVertices, size_t size, BufferUsage usage)
+	VertexBufferHandle GraphicsSystem::CreateVertexBuffer(const void* pVertices, size_t size, BufferUsage usage)
 	{
-		VertexBuffer* buffer = iol_alloc(VertexBuffer);
+		VertexBuffer buffer;
 
-		glGenBuffers(1, &buffer->id);
-		glBindBuffer(GL_ARRAY_BUFFER, buffer->id);
+		glGenBuffers(1, &buffer.id);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer.id);
 		glBufferData(GL_ARRAY_BUFFER, size, pVertices, gl::ConvertBufferUsage(usage));
 
-		return buffer;
+		return m_data->vertexBuffers.Add(buffer);
 	}
 
-	void GraphicsSystem::DestroyVertexBuffer(VertexBuffer* pVertexBuffer)
+	void GraphicsSystem::DestroyVertexBuffer(VertexBufferHandle vertexBuffer)
 	{
-		GLuint id = pVertexBuffer->id;
+		GLuint id = graphics_get_resource(m_data->vertexBuffers, vertexBuffer)->id;
 		glDeleteBuffers(1, &id);
-		iol_free(pVertexBuffer);
+		m_data->vertexBuffers.Remove(vertexBuffer);
 	}
 
-	void* GraphicsSystem::MapVertexBuffer(VertexBuffer* pVertexBuffer, BufferAccess access)
+	void* GraphicsSystem::MapVertexBuffer(VertexBufferHandle vertexBuffer, BufferAccess access)
 	{
-		GLuint id = pVertexBuffer->id;
+		GLuint id = graphics_get_resource(m_data->vertexBuffers, vertexBuffer)->id;
 		void* pMappedBuffer;
 		pMappedBuffer = glMapNamedBuffer(id, gl::ConvertBufferAccess(access));
 
 		return pMappedBuffer;
 	}
 
-	void GraphicsSystem::UnmapVertexBuffer(VertexBuffer* pVertexBuffer)
+	void GraphicsSystem::UnmapVertexBuffer(VertexBufferHandle vertexBuffer)
 	{
-		GLuint id = ((VertexBuffer*)pVertexBuffer)->id;
+		GLuint id = graphics_get_resource(m_data->vertexBuffers, vertexBuffer)->id;
 		glUnmapNamedBuffer(id);
 	}
 
-	void GraphicsSystem::SetVertexBufferData(VertexBuffer* pVertexBuffer, const void* pVertices, size_t size)
+	void GraphicsSystem::SetVertexBufferData(VertexBufferHandle vertexBuffer, const void* pVertices, size_t size)
 	{
-		void* pMapped = GraphicsSystem::MapVertexBuffer(pVertexBuffer, BufferAccess::Write);
+		void* pMapped = GraphicsSystem::MapVertexBuffer(vertexBuffer, BufferAccess::Write);
 		memory::Copy(pMapped, size, pVertices);
-		GraphicsSystem::UnmapVertexBuffer(pVertexBuffer);
+		GraphicsSystem::UnmapVertexBuffer(vertexBuffer);
 	}
 
-	IndexBuffer* GraphicsSystem::CreateIndexBuffer(uint32* pIndices, size_t numIndices, BufferUsage usage)
+	IndexBufferHandle GraphicsSystem::CreateIndexBuffer(uint32* pIndices, size_t numIndices, BufferUsage usage)
 	{
-		IndexBuffer* pBuffer = iol_alloc(IndexBuffer);
+		IndexBuffer buffer;
 
-		glGenBuffers(1, &pBuffer->id);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pBuffer->id);
+		glGenBuffers(1, &buffer.id);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.id);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(*pIndices) * numIndices, pIndices, gl::ConvertBufferUsage(usage));
-		pBuffer->numIndices = numIndices;
+		buffer.numIndices = numIndices;
 
-		return pBuffer;
+		return m_data->indexBuffers.Add(buffer);
 	}
 
-	void GraphicsSystem::DestroyIndexBuffer(IndexBuffer* pIndexBuffer)
+	void GraphicsSystem::DestroyIndexBuffer(IndexBufferHandle indexBuffer)
 	{
-		GLuint id = pIndexBuffer->id;
+		GLuint id = graphics_get_resource(m_data->indexBuffers, indexBuffer)->id;
 		glDeleteBuffers(1, &id);
-		iol_free(pIndexBuffer);
+		m_data->indexBuffers.Remove(indexBuffer);
 	}
 
-	void* GraphicsSystem::MapIndexBuffer(IndexBuffer* pIndexBuffer, BufferAccess access)
+	void* GraphicsSystem::MapIndexBuffer(IndexBufferHandle indexBuffer, BufferAccess access)
 	{
-		GLuint id = pIndexBuffer->id;
+		GLuint id = graphics_get_resource(m_data->indexBuffers, indexBuffer)->id;
 		void* pMappedBuffer;
 		pMappedBuffer = glMapNamedBuffer(id, gl::ConvertBufferAccess(access));
 
 		return pMappedBuffer;
 	}
 
-	void GraphicsSystem::UnmapIndexBuffer(IndexBuffer* pIndexBuffer)
+	void GraphicsSystem::UnmapIndexBuffer(IndexBufferHandle indexBuffer)
 	{
-		GLuint id = pIndexBuffer->id;
+		GLuint id = graphics_get_resource(m_data->indexBuffers, indexBuffer)->id;
 		glUnmapNamedBuffer(id);
 	}
 
-	void GraphicsSystem::SetIndexBufferData(IndexBuffer* pIndexBuffer, uint32* pIndices, size_t numIndices)
+	void GraphicsSystem::SetIndexBufferData(IndexBufferHandle indexBuffer, uint32* pIndices, size_t numIndices)
 	{
-		void* pMapped = GraphicsSystem::MapIndexBuffer(pIndexBuffer, BufferAccess::Write);
+		void* pMapped = GraphicsSystem::MapIndexBuffer(indexBuffer, BufferAccess::Write);
 		memory::Copy(pMapped, numIndices * sizeof(uint32), pIndices);
-		GraphicsSystem::UnmapIndexBuffer(pIndexBuffer);
+		GraphicsSystem::UnmapIndexBuffer(indexBuffer);
 	}
 
-	size_t GraphicsSystem::GetIndexBufferNumIndices(const IndexBuffer* pIndexBuffer)
+	size_t GraphicsSystem::GetIndexBufferNumIndices(IndexBufferHandle indexBuffer)
 	{
-		return pIndexBuffer->numIndices;
+		return graphics_get_resource(m_data->indexBuffers, indexBuffer)->numIndices;
 	}
 
-	UniformBuffer* GraphicsSystem::CreateUniformBuffer(const void* pData, size_t size, BufferUsage usage, const char* pName)
+	UniformBufferHandle GraphicsSystem::CreateUniformBuffer(const void* pData, size_t size, BufferUsage usage, const char* pName)
 	{
 		iol_assert(size % 16 == 0); // buffer data must be 16 bytes aligned
 
-		UniformBuffer* pBuffer = iol_alloc(UniformBuffer);
+		UniformBuffer buffer;
 
-		pBuffer->pName = pName;
+		buffer.name = string_id::Intern(pName);
 
-		glGenBuffers(1, &pBuffer->id);
-		glBindBuffer(GL_UNIFORM_BUFFER, pBuffer->id);
+		glGenBuffers(1, &buffer.id);
+		glBindBuffer(GL_UNIFORM_BUFFER, buffer.id);
 		glBufferData(GL_UNIFORM_BUFFER, size, pData, gl::ConvertBufferUsage(usage));
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
-		return pBuffer;
+		return m_data->uniformBuffers.Add(buffer);
 	}
 
-	void GraphicsSystem::DestroyUniformBuffer(UniformBuffer* pBuffer)
+	void GraphicsSystem::DestroyUniformBuffer(UniformBufferHandle buffer)
 	{
-		GLuint id = pBuffer->id;
+		GLuint id = graphics_get_resource(m_data->uniformBuffers, buffer)->id;
 
 		glDeleteBuffers(1, &id);
-		iol_free(pBuffer);
+		m_data->uniformBuffers.Remove(buffer);
 	}
 
-	void* GraphicsSystem::MapUniformBuffer(UniformBuffer* pBuffer, BufferAccess access)
+	void* GraphicsSystem::MapUniformBuffer(UniformBufferHandle buffer, BufferAccess access)
 	{
-		GLuint id = pBuffer->id;
+		GLuint id = graphics_get_resource(m_data->uniformBuffers, buffer)->id;
 		void* pMappedBuffer;
 		pMappedBuffer = glMapNamedBuffer(id, gl::ConvertBufferAccess(access));
 
 		return pMappedBuffer;
 	}
 
-	void GraphicsSystem::UnmapUniformBuffer(UniformBuffer* pBuffer)
+	void GraphicsSystem::UnmapUniformBuffer(UniformBufferHandle buffer)
 	{
-		GLuint id = pBuffer->id;
+		GLuint id = graphics_get_resource(m_data->uniformBuffers, buffer)->id;
 		glUnmapNamedBuffer(id);
 	}
 
-	void GraphicsSystem::SetUniformBufferData(UniformBuffer* pBuffer, const void* pData, size_t size)
+	void GraphicsSystem::SetUniformBufferData(UniformBufferHandle buffer, const void* pData, size_t size)
 	{
-		void* pMapped = GraphicsSystem::MapUniformBuffer(pBuffer, BufferAccess::Write);
+		void* pMapped = GraphicsSystem::MapUniformBuffer(buffer, BufferAccess::Write);
 		memory::Copy(pMapped, size, pData);
-		GraphicsSystem::UnmapUniformBuffer(pBuffer);
+		GraphicsSystem::UnmapUniformBuffer(buffer);
 	}
 
-	VertexLayout* GraphicsSystem::CreateVertexLayout(const Shader* pShader, const VertexAttributeParam* pVertexAttributeParams, size_t numVertexAttributes)
+	VertexLayoutHandle GraphicsSystem::CreateVertexLayout(ShaderHandle shader, const VertexAttributeParam* pVertexAttributeParams, size_t numVertexAttributes)
 	{
-		VertexLayout* pVertexLayout = iol_alloc(VertexLayout);
-		graphics_base::CreateVertexLayout(&pVertexLayout->base, pVertexAttributeParams, numVertexAttributes, gl::GetSizeOfVertexType);
+		VertexLayout vertexLayout;
+		graphics_base::CreateVertexLayout(&vertexLayout.base, pVertexAttributeParams, numVertexAttributes, gl::GetSizeOfVertexType);
 
-		return pVertexLayout;
+		return m_data->vertexLayouts.Add(std::move(vertexLayout));
 	}
 
-	void GraphicsSystem::DestroyVertexLayout(VertexLayout* pVertexLayout)
+	void GraphicsSystem::DestroyVertexLayout(VertexLayoutHandle vertexLayout)
 	{
-		graphics_base::DestroyVertexLayout(&pVertexLayout->base);
-		iol_free(pVertexLayout);
+		graphics_base::DestroyVertexLayout(&graphics_get_resource(m_data->vertexLayouts, vertexLayout)->base);
+		m_data->vertexLayouts.Remove(vertexLayout);
 	}
 	
-	VertexArray* GraphicsSystem::CreateVertexArray(VertexLayout* pVertexLayout, const VertexBuffer** pVertexBuffers, size_t numVertexBuffers, IndexBuffer* pIndexBuffer)
+	VertexArrayHandle GraphicsSystem::CreateVertexArray(VertexLayoutHandle vertexLayout, const VertexBufferHandle* pVertexBuffers, size_t numVertexBuffers, IndexBufferHandle indexBuffer)
 	{
-		VertexArray* pVAO = iol_alloc(VertexArray);
+		VertexArray vao;
 
-		glGenVertexArrays(1, &pVAO->id);
-		glBindVertexArray(pVAO->id);
+		glGenVertexArrays(1, &vao.id);
+		glBindVertexArray(vao.id);
 
-		VertexLayoutBase* pInputLayout = &pVertexLayout->base;
+		const VertexLayoutBase* pInputLayout = &graphics_get_resource(m_data->vertexLayouts, vertexLayout)->base;
 
-		if (pIndexBuffer != nullptr)
+		if (!indexBuffer.IsNull())
 		{
-			IndexBuffer* pIndexBufferImpl = (IndexBuffer*)pIndexBuffer;
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pIndexBufferImpl->id);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, graphics_get_resource(m_data->indexBuffers, indexBuffer)->id);
 		}
 
-		for (size_t i = 0; i < pInputLayout->numVertexAttributes; i++)
+		for (size_t i = 0; i < pInputLayout->vertexAttributes.count; i++)
 		{
 			const VertexAttribute* attribute = &pInputLayout->vertexAttributes[i];
 			GLuint attribIdx = (GLuint)i;
@@ -542,7 +576,8 @@ namespace iol
 
 			glEnableVertexAttribArray(attribIdx);
 
-			glBindBuffer(GL_ARRAY_BUFFER, pVertexBuffers[vertexBufferIdx]->id);
+			iol_assert(vertexBufferIdx < numVertexBuffers);
+			glBindBuffer(GL_ARRAY_BUFFER, graphics_get_resource(m_data->vertexBuffers, pVertexBuffers[vertexBufferIdx])->id);
 
 			glVertexAttribPointer(
 				attribIdx,
@@ -557,27 +592,27 @@ namespace iol
 		}
 
 #if IOL_DEBUG
-		pVAO->pVertexLayout = pVertexLayout;
-		pVAO->pVertexBuffers = pVertexBuffers;
-		pVAO->numVertexBuffers = numVertexBuffers;
-		pVAO->pIndexBuffer = pIndexBuffer;
+		vao.vertexLayout = vertexLayout;
+		vao.numVertexBuffers = numVertexBuffers;
+		vao.indexBuffer = indexBuffer;
 #endif
 
-		return pVAO;
+		return m_data->vertexArrays.Add(vao);
 	}
 
-	void GraphicsSystem::DestroyVertexArray(VertexArray* pVertexArray)
+	void GraphicsSystem::DestroyVertexArray(VertexArrayHandle vertexArray)
 	{
-		glDeleteVertexArrays(1, &pVertexArray->id);
-		iol_free(pVertexArray);
+		glDeleteVertexArrays(1, &graphics_get_resource(m_data->vertexArrays, vertexArray)->id);
+		m_data->vertexArrays.Remove(vertexArray);
 	}
 
-	GLuint gl::CompileShader(GLuint shaderType, const char* pSourceCode)
+	GLuint gl::CompileShader(GLuint shaderType, StringView sourceCode)
 	{
 		GLuint shader;
 		shader = glCreateShader(shaderType);
 
-		glShaderSource(shader, 1, &pSourceCode, NULL);
+		GLint sourceLength = (GLint)sourceCode.length;
+		glShaderSource(shader, 1, &sourceCode.pData, &sourceLength);
 		glCompileShader(shader);
 
 		GLint compileStatus;
@@ -595,89 +630,97 @@ namespace iol
 		return shader;
 	}
 
-	Shader* GraphicsSystem::CreateShader(const char* pSourceCode)
+	ShaderUniformBlock* gl::GetShaderUniformBlock(const Shader* pShader, StringId name)
 	{
-		Shader* pShader = iol_alloc(Shader);
+		for (uint32 i = 0; i < pShader->numUniformBlocks; ++i)
+		{
+			if (pShader->uniformBlocks[i].name == name)
+				return &pShader->uniformBlocks[i];
+		}
 
-		const char* pShaderTypeKey = "#type";
-		size_t shaderTypeKeyLength = string::GetLength(pShaderTypeKey);
+		iol_assert(pShader->numUniformBlocks < SHADER_MAX_UNIFORM_BLOCKS);
 
-		const char* shaderTypes[] = { "vertex", "fragment" };
-		const char* pCodeStarts[iol_countof(shaderTypes)];
-		const char* pCodeEnds[iol_countof(shaderTypes)];
+		ShaderUniformBlock* pBlock = &pShader->uniformBlocks[pShader->numUniformBlocks++];
+		pBlock->name = name;
+		pBlock->index = glGetUniformBlockIndex(pShader->programId, string_id::GetString(name));
+		pBlock->binding = GL_INVALID_INDEX;
+		iol_assert(pBlock->index != GL_INVALID_INDEX);
 
-		memory::FillZero(pCodeStarts, sizeof(pCodeStarts));
-		memory::FillZero(pCodeEnds, sizeof(pCodeEnds));
+		return pBlock;
+	}
 
-		const char* pCurrent = pSourceCode;
+	ShaderHandle GraphicsSystem::CreateShader(const char* pSourceCode)
+	{
+		Shader shader;
+		shader.numUniformBlocks = 0;
+
+		const StringView shaderTypeKey("#type");
+		const StringView shaderTypes[] = { "vertex", "fragment" };
+		StringView shaderSources[iol_countof(shaderTypes)];
 
-		while (pCurrent && *pCurrent)
+		StringView source(pSourceCode);
+		const char* pCurrent = string::Find(source, shaderTypeKey);
+
+		while (pCurrent)
 		{
-			pCurrent = string::Find(pCurrent, pShaderTypeKey) + shaderTypeKeyLength;
-			pCurrent = string::Skip(pCurrent, " \t");
+			StringView remaining = string::CreateView(pCurrent + shaderTypeKey.length, source.GetEnd());
+			StringView shaderType = string::Trim(string::SplitLine(&remaining));
+
+			pCurrent = string::Find(remaining, shaderTypeKey);
+			const char* pCodeEnd = pCurrent ? pCurrent : remaining.GetEnd();
 
 			for (size_t i = 0; i < iol_countof(shaderTypes); ++i)
 			{
-				if (string::Compare(pCurrent, shaderTypes[i]))
+				if (string::Equals(shaderType, shaderTypes[i]))
 				{
-					pCurrent = string::GetNextLine(pCurrent);
-					pCodeStarts[i] = pCurrent;
-
-					pCurrent = string::Find(pCurrent, pShaderTypeKey);
-					pCodeEnds[i] = pCurrent;
+					shaderSources[i] = string::CreateView(remaining.pData, pCodeEnd);
 					break;
 				}
 			}
 		}
 
-		if (pCodeStarts[0] == nullptr || pCodeStarts[1] == nullptr)
+		if (shaderSources[0].pData == nullptr || shaderSources[1].pData == nullptr)
 		{
 			iol_log_error("failed to find all required shader types");
-			return nullptr;
+			return ShaderHandle();
 		}
 
-		char* pVertexShaderSource = string::SubstringAlloc(pCodeStarts[0], pCodeEnds[0]);
-		char* pFragmentShaderSource = string::SubstringAlloc(pCodeStarts[1], pCodeEnds[1]);
-
-		pShader->programId = glCreateProgram();
+		shader.programId = glCreateProgram();
 
-		GLuint vertexShader = gl::CompileShader(GL_VERTEX_SHADER, pVertexShaderSource);
+		GLuint vertexShader = gl::CompileShader(GL_VERTEX_SHADER, shaderSources[0]);
 		iol_assert(vertexShader != (GLuint)-1);
 
-		GLuint fragmentShader = gl::CompileShader(GL_FRAGMENT_SHADER, pFragmentShaderSource);
+		GLuint fragmentShader = gl::CompileShader(GL_FRAGMENT_SHADER, shaderSources[1]);
 		iol_assert(fragmentShader != (GLuint)-1);
 
-		glAttachShader(pShader->programId, vertexShader);
-		glAttachShader(pShader->programId, fragmentShader);
+		glAttachShader(shader.programId, vertexShader);
+		glAttachShader(shader.programId, fragmentShader);
 
-		glLinkProgram(pShader->programId);
-		glValidateProgram(pShader->programId);
+		glLinkProgram(shader.programId);
+		glValidateProgram(shader.programId);
 
 		glDeleteShader(vertexShader);
 		glDeleteShader(fragmentShader);
 
-		iol_free(pVertexShaderSource);
-		iol_free(pFragmentShaderSource);
-
-		return pShader;
+		return m_data->shaders.Add(shader);
 	}
 
-	void GraphicsSystem::DestroyShader(Shader* pShader)
+	void GraphicsSystem::DestroyShader(ShaderHandle shader)
 	{
-		glDeleteProgram(pShader->programId);
-		iol_free(pShader);
+		glDeleteProgram(graphics_get_resource(m_data->shaders, shader)->programId);
+		m_data->shaders.Remove(shader);
 	}
 
-	Shader* GraphicsSystem::CreateShaderFromFile(const char* pFilePath)
+	ShaderHandle GraphicsSystem::CreateShaderFromFile(const char* pFilePath)
 	{
-		char* pShaderSource = file::ReadAllText(pFilePath, nullptr, 0u);
-		Shader* pShader = GraphicsSystem::CreateShader(pShaderSource);
+		char* pShaderSource = vfs::ReadAllText(pFilePath, nullptr);
+		ShaderHandle shader = GraphicsSystem::CreateShader(pShaderSource);
 		iol_free(pShaderSource);
 
-		return pShader;
+		return shader;
 	}
 
-	Texture* gl::CreateTexture(int32 width, int32 height, const TextureParam& param, uint32 color, const void* pDataUncompressed)
+	void gl::CreateTexture(Texture* pTexture, int32 width, int32 height, const TextureParam& param, uint32 color, const void* pDataUncompressed)
 	{
 		uint32 format;
 
@@ -686,7 +729,6 @@ namespace iol
 		else
 			format = GL_RGBA;
 
-		Texture* pTexture = iol_alloc(Texture);
 		pTexture->width = width;
 		pTexture->height = height;
 
@@ -758,19 +800,17 @@ namespace iol
 
 		if (param.genMipMaps)
 			glGenerateMipmap(GL_TEXTURE_2D);
-
-		return pTexture;
 	}
 
-	Texture* GraphicsSystem::CreateTextureFromFile(const char* pFilePath, const TextureParam& param)
+	TextureHandle GraphicsSystem::CreateTextureFromFile(const char* pFilePath, const TextureParam& param)
 	{
-		size_t size;
-		uint8* pDataCompressed = (uint8*)file::ReadAll(pFilePath, &size, 0u);
+		// stb decodes straight from the page cache, the compressed file is never copied to the heap
+		FileMapping mapping;
 
-		if (pDataCompressed == nullptr)
+		if (!vfs::Map(pFilePath, &mapping))
 		{
 			iol_log_error("Failed to load texture. File not found: '%s'", pFilePath);
-			return nullptr;
+			return TextureHandle();
 		}
 
 		int32 width, height, numChannels;
@@ -786,50 +826,54 @@ namespace iol
 		}
 
 		stbi_set_flip_vertically_on_load(1);
-		uint8* pDataUncompressed = stbi_load_from_memory(pDataCompressed, (int)size, &width, &height, &numChannels, numChannels);
-		iol_free(pDataCompressed);
+		uint8* pDataUncompressed = stbi_load_from_memory(mapping.pData, (int)mapping.size, &width, &height, &numChannels, numChannels);
+		vfs::Unmap(&mapping);
 
 		if (pDataUncompressed == nullptr)
 		{
 			iol_log_error("Failed to read texture: '%s'", pFilePath);
-			return nullptr;
+			return TextureHandle();
 		}
 
-		Texture* texture = gl::CreateTexture(width, height, param, 0, pDataUncompressed);
+		Texture texture;
+		gl::CreateTexture(&texture, width, height, param, 0, pDataUncompressed);
 		stbi_image_free(pDataUncompressed);
 
-		return texture;
+		return m_data->textures.Add(texture);
 	}
 
-	Texture* GraphicsSystem::CreateTexture(uint32 width, uint32 height, uint32 color, const TextureParam& param)
+	TextureHandle GraphicsSystem::CreateTexture(uint32 width, uint32 height, uint32 color, const TextureParam& param)
 	{
-		return gl::CreateTexture(width, height, param, color, nullptr);
+		Texture texture;
+		gl::CreateTexture(&texture, width, height, param, color, nullptr);
+
+		return m_data->textures.Add(texture);
 	}
 
-	void GraphicsSystem::DestroyTexture(Texture* pTexture)
+	void GraphicsSystem::DestroyTexture(TextureHandle texture)
 	{
-		glDeleteTextures(1, &pTexture->id);
-		iol_free(pTexture);
+		glDeleteTextures(1, &graphics_get_resource(m_data->textures, texture)->id);
+		m_data->textures.Remove(texture);
 	}
 
-	RenderTarget* GraphicsSystem::CreateRenderTarget(uint32 width, uint32 height, RenderTargetFlags flags)
+	RenderTargetHandle GraphicsSystem::CreateRenderTarget(uint32 width, uint32 height, RenderTargetFlags flags)
 	{
 		iol_assert(false);
-		return nullptr;
+		return RenderTargetHandle();
 	}
 
-	void GraphicsSystem::DestroyRenderTarget(RenderTarget* pRenderTarget)
+	void GraphicsSystem::DestroyRenderTarget(RenderTargetHandle renderTarget)
 	{
 		iol_assert(false);
 	}
 
-	void GraphicsSystem::BeginRender(const GraphicsPipelineState* pPipelineState)
+	void GraphicsSystem::BeginRender(GraphicsPipelineStateHandle pipelineState)
 	{
 		ImGui_ImplOpenGL3_NewFrame();
 		ImGui_ImplSDL2_NewFrame();
 		ImGui::NewFrame();
 
-		GraphicsSystem::SetPipelineState(pPipelineState);
+		GraphicsSystem::SetPipelineState(pipelineState);
 
 		ImGuiViewport* viewport = ImGui::GetMainViewport();
 		ImGui::DockSpaceOverViewport(0, viewport, ImGuiDockNodeFlags_PassthruCentralNode, 0);
@@ -881,52 +925,57 @@ namespace iol
 
 	void GraphicsSystem::Draw(size_t startVertexIndex, size_t numVertices)
 	{
-		glDrawArrays(m_data->pPipelineState->primitiveType, (GLint)startVertexIndex, (GLsizei)numVertices);
+		glDrawArrays(m_data->pipelineState.primitiveType, (GLint)startVertexIndex, (GLsizei)numVertices);
 	}
 
 	void GraphicsSystem::DrawIndexed(size_t numIndices)
 	{
-		glDrawElements(m_data->pPipelineState->primitiveType, (GLsizei)numIndices, GL_UNSIGNED_INT, nullptr);
+		glDrawElements(m_data->pipelineState.primitiveType, (GLsizei)numIndices, GL_UNSIGNED_INT, nullptr);
 	}
 
 	void GraphicsSystem::DrawInstanced(size_t startVertexIndex, size_t numVertices, size_t numInstances)
 	{
-		glDrawArraysInstanced(m_data->pPipelineState->primitiveType, (GLint)startVertexIndex, (GLsizei)numVertices, (GLsizei)numInstances);
+		glDrawArraysInstanced(m_data->pipelineState.primitiveType, (GLint)startVertexIndex, (GLsizei)numVertices, (GLsizei)numInstances);
 	}
 
 	void GraphicsSystem::DrawIndexedInstanced(size_t numIndices, size_t numInstances)
 	{
-		glDrawElementsInstanced(m_data->pPipelineState->primitiveType, (GLsizei)numIndices, GL_UNSIGNED_INT, nullptr, (GLsizei)numInstances);
+		glDrawElementsInstanced(m_data->pipelineState.primitiveType, (GLsizei)numIndices, GL_UNSIGNED_INT, nullptr, (GLsizei)numInstances);
 	}
 
-	void GraphicsSystem::BindVertexArray(const VertexArray* pVertexArray)
+	void GraphicsSystem::BindVertexArray(VertexArrayHandle vertexArray)
 	{
+		const VertexArray* pVertexArray = graphics_get_resource(m_data->vertexArrays, vertexArray);
+
 #ifdef IOL_DEBUG
 		// PipelineState stores the VertexLayout (required for D3D12),
 		// so for compatibility reasons the VertexLayout is not allowed to change during the execution of a GraphicsCommandList.
-		iol_assert(pVertexArray->pVertexLayout == m_data->pPipelineState->pVertexLayout);
+		iol_assert(pVertexArray->vertexLayout == m_data->pipelineState.vertexLayout);
 #endif
 
 		glBindVertexArray(pVertexArray->id);
 	}
 
-	void GraphicsSystem::BindUniformBuffer(const UniformBuffer** pBuffers, size_t numBuffers)
+	void GraphicsSystem::BindUniformBuffer(const UniformBufferHandle* pBuffers, size_t numBuffers)
 	{
-		const GraphicsPipelineState* pState = m_data->pPipelineState;
+		const Shader* pShader = graphics_get_resource(m_data->shaders, m_data->pipelineState.shader);
 
 		for (GLuint i = 0; i < numBuffers; ++i)
 		{
-			const UniformBuffer* pCBuffer = (const UniformBuffer*)pBuffers[i];
+			const UniformBuffer* pCBuffer = graphics_get_resource(m_data->uniformBuffers, pBuffers[i]);
+			ShaderUniformBlock* pBlock = gl::GetShaderUniformBlock(pShader, pCBuffer->name);
 
-			GLuint blockIdx = glGetUniformBlockIndex(pState->pShader->programId, pCBuffer->pName);
-			iol_assert(blockIdx != (GLuint)-1);
+			if (pBlock->binding != i)
+			{
+				glUniformBlockBinding(pShader->programId, pBlock->index, i);
+				pBlock->binding = i;
+			}
 
-			glUniformBlockBinding(pState->pShader->programId, blockIdx, i);
 			glBindBufferBase(GL_UNIFORM_BUFFER, i, pCBuffer->id);
 		}
 	}
 
-	void GraphicsSystem::BindTexture(size_t startSlot, const Texture** pTextures, size_t numTextures)
+	void GraphicsSystem::BindTexture(size_t startSlot, const TextureHandle* pTextures, size_t numTextures)
 	{
 		GLuint start = (GLuint)startSlot;
 		GLuint slotIdx;
@@ -934,7 +983,7 @@ namespace iol
 
 		for (slotIdx = start, i = 0; slotIdx < start + numTextures; ++slotIdx, ++i)
 		{
-			Texture* pTextureImpl = (Texture*)pTextures[i];
+			const Texture* pTextureImpl = graphics_get_resource(m_data->textures, pTextures[i]);
 
 			glActiveTexture(s_textureSlots[slotIdx]);
 			glBindTexture(GL_TEXTURE_2D, pTextureImpl->id);
@@ -956,17 +1005,18 @@ namespace iol
 		SetViewport(vp);
 	}
 
-	void GraphicsSystem::SetPipelineState(const GraphicsPipelineState* pPipelineState)
+	void GraphicsSystem::SetPipelineState(GraphicsPipelineStateHandle pipelineState)
 	{
 		GraphicsSystemData* pSystem = m_data;
 
-		const GraphicsPipelineState* pState = (const GraphicsPipelineState*)pPipelineState;
-		pSystem->pPipelineState = pState;
+		pSystem->pipelineState = *graphics_get_resource(pSystem->pipelineStates, pipelineState);
+		const GraphicsPipelineState* pState = &pSystem->pipelineState;
+		const Shader* pShader = graphics_get_resource(pSystem->shaders, pState->shader);
 
-		if (pSystem->shaderProgramId != pState->pShader->programId)
+		if (pSystem->shaderProgramId != pShader->programId)
 		{
-			pSystem->shaderProgramId = pState->pShader->programId;
-			glUseProgram(pState->pShader->programId);
+			pSystem->shaderProgramId = pShader->programId;
+			glUseProgram(pShader->programId);
 		}
 
 		if ((pSystem->rasterizerFlags & RasterizerFlags_BackFaceCulling) != (pState->rasterizerFlags & RasterizerFlags_BackFaceCulling))
@@ -25,8 +25,9 @@
 #include "iol_memory.h"
 #include "iol_array.h"
 #include "iol_string.h"
+#include "iol_string_id.h"
 #include "iol_event.h"
-#include "iol_file.h"
+#include "iol_vfs.h"
 
 namespace iol
 {
@@ -63,15 +64,26 @@ namespace iol
 
 	};
 
+#define SHADER_MAX_UNIFORM_BLOCKS 16
+
+	struct ShaderUniformBlock
+	{
+		StringId name;
+		GLuint index;
+		GLuint binding; // GL_INVALID_INDEX until the block was bound once
+	};
+
 	struct Shader
 	{
 		GLuint programId;
+		mutable ShaderUniformBlock uniformBlocks[SHADER_MAX_UNIFORM_BLOCKS]; // resolved block indices, avoids glGetUniformBlockIndex on every bind
+		mutable uint32 numUniformBlocks;
 	};
 
 	struct UniformBuffer
 	{
 		GLuint id;
-		const char* pName;
+		StringId name;
 	};
 
 	struct VertexLayout
@@ -95,10 +107,9 @@ namespace iol
 		GLuint id;
 
 #ifdef IOL_DEBUG
-		VertexLayout* pVertexLayout;
-		const VertexBuffer** pVertexBuffers;
+		VertexLayoutHandle vertexLayout;
 		size_t numVertexBuffers;
-		IndexBuffer* pIndexBuffer;
+		IndexBufferHandle indexBuffer;
 #endif // IOL_DEBUG
 	};
 
@@ -109,10 +120,11 @@ namespace iol
 		uint32        ConvertVertexType(VertexType type);
 		uint32        GetSizeOfVertexType(VertexType basicType);
 		uint32        ConvertPrimitiveType(PrimitiveType primitiveType);
-		GLuint        CompileShader(GLuint shaderType, const char* pSourceCode);
+		GLuint        CompileShader(GLuint shaderType, StringView sourceCode);
+		ShaderUniformBlock* GetShaderUniformBlock(const Shader* pShader, StringId name);
 		void          SetBlendMode(BlendMode blendMode);
 		uint32        ConvertTextureFilter(TextureFilter filter);
-		Texture*      CreateTexture(int32 width, int32 height, const TextureParam& param, uint32 color, const void* pDataUncompressed);
+		void          CreateTexture(Texture* pTexture, int32 width, int32 height, const TextureParam& param, uint32 color, const void* pDataUncompressed);
 
 #ifdef IOL_DEBUG
 		void          HandleDebugEvent(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam);
@@ -1,6 +1,11 @@
 #include "iol_mesh.h"
-#include "iol_file.h"
-#include "iol_hashmap.h"
+#include "mesh_obj.h"
+#include "iol_core.h"
+#include "iol_vfs.h"
+#include "iol_binary_stream.h"
+#include "iol_flat_hashmap.h"
+#include "iol_hash.h"
+#include "iol_string.h"
 #include "glm/gtx/rotate_vector.hpp"
 #include "glm/ext/quaternion_common.hpp"
 #include "glm/gtx/norm.hpp"
@@ -10,6 +15,10 @@
 #define DB_PERLIN_IMPL
 #include "db_perlin.hpp"
 
+#define MESH_CACHE_DIRECTORY "cache/mesh"
+#define MESH_CACHE_PATH_CAPACITY 256
+#define MESH_CACHE_SEED 2 // change whenever the obj conversion changes, so stale cache files are no longer found
+
 using namespace glm;
 
 namespace iol
@@ -55,17 +64,16 @@ namespace iol
 		}
 	};
 
-	uint32 GetHashForIndexCombination(const MeshVertexKey& key)
-	{
-		return (key.iPos * 293 + key.iUV * 127 + key.iNormal * 41);
-	}
-
 	Mesh::Mesh()
 	{
+		m_binFileMapping.pData = nullptr;
+		m_binFileMapping.size = 0;
+		m_binFileMapping.pHandle = nullptr;
 	}
 
 	Mesh::~Mesh()
 	{
+		ReleaseBinFile();
 	}
 
 	void Mesh::LoadPrimitive(MeshPrimitiveType type)
@@ -95,6 +103,8 @@ namespace iol
 
 	void Mesh::LoadQuad()
 	{
+		ReleaseBinFile();
+
 		float s = 0.5f;
 
 		positions.Create(4);
@@ -136,6 +146,8 @@ namespace iol
 
 	void Mesh::LoadTerrain(float size, size_t numQuadsPerSide, float tileX, float tileY)
 	{
+		ReleaseBinFile();
+
 		terrainNumVerticesPerSide = numQuadsPerSide + 1; // One extra vertex per row/column for shared edges
 		terrainSize = size;
 		terrainQuadSize = size / numQuadsPerSide;
@@ -201,6 +213,8 @@ namespace iol
 
 	void Mesh::LoadCube()
 	{
+		ReleaseBinFile();
+
 		size_t vertexCount = 36; // 3 * 2 * 6
 		float s = 0.5f;
 
@@ -346,130 +360,57 @@ namespace iol
 
 	bool Mesh::LoadObjFile(const char* pFilePath)
 	{
-		size_t fileSize;
-		char* pBuffer = file::ReadAllText(pFilePath, &fileSize, 0u);
+		FileMapping mapping;
 
-		char* pCurrent = pBuffer;
-		char* pEnd = pBuffer + fileSize;
-		size_t numPositions = 0, numUVs = 0, numNormals = 0, numIndices = 0;
-
-		while (pCurrent < pEnd)
+		if (!vfs::Map(pFilePath, &mapping))
 		{
-			if (pCurrent[0] == 'v')
-			{
-				if (pCurrent[1] == ' ')
-				{
-					numPositions++;
-				}
-				else if (pCurrent[1] == 't')
-				{
-					numUVs++;
-				}
-				else if (pCurrent[1] == 'n')
-				{
-					numNormals++;
-				}
-			}
-			else if (pCurrent[0] == 'f')
-			{
-				numIndices += 3;
-			}
-
-			char* pLineEnd = strchr(pCurrent, '\n');
-
-			if (pLineEnd)
-				pCurrent = pLineEnd;
-
-			pCurrent++;
+			iol_log_error("Failed to load obj file: '%s'", pFilePath);
+			return false;
 		}
 
-		Array<vec3> positions(numPositions);
-		Array<vec2> uvs(numUVs);
-		Array<vec3> normals(numNormals);
+		uint64 sourceHash = hash::Bytes(mapping.pData, mapping.size, MESH_CACHE_SEED);
+		char cachePath[MESH_CACHE_PATH_CAPACITY];
+		snprintf(cachePath, sizeof(cachePath), MESH_CACHE_DIRECTORY "/%016llx.iolmesh", (unsigned long long)sourceHash);
 
-		Array<uint32> indicesPos(numIndices);
-		Array<uint32> indicesUV(numIndices);
-		Array<uint32> indicesNormal(numIndices);
-
-		size_t i;
-		float x, y, z;
-		uint32 ip0, ip1, ip2;
-		uint32 iuv0, iuv1, iuv2;
-		uint32 in0, in1, in2;
-		pCurrent = pBuffer;
-
-		while (pCurrent <= pEnd)
+		if (vfs::Exists(cachePath) && LoadBinFile(cachePath, sourceHash, false))
 		{
-			if (pCurrent[0] == 'v')
-			{
-				if (pCurrent[1] == ' ')
-				{
-					// Position
-					if (sscanf(pCurrent, "v %f %f %f", &x, &y, &z) == 3)
-					{
-						positions.PushBack(vec3(x, y, z));
-					}
-				}
-				else if (pCurrent[1] == 't')
-				{
-					// UV
-					if (sscanf(pCurrent, "vt %f %f", &x, &y) == 2)
-					{
-						uvs.PushBack(vec2(x, y));
-					}
-				}
-				else if (pCurrent[1] == 'n')
-				{
-					// Normal
-					if (sscanf(pCurrent, "vn %f %f %f", &x, &y, &z) == 3)
-					{
-						normals.PushBack(vec3(x, y, z));
-					}
-				}
-			}
-			else if (pCurrent[0] == 'f')
-			{
-				// Index
-				if (sscanf(pCurrent, "f %u/%u/%u %u/%u/%u %u/%u/%u", &ip0, &iuv0, &in0, &ip1, &iuv1, &in1, &ip2, &iuv2, &in2) == 9)
-				{
-					indicesPos.PushBack(ip0 - 1);
-					indicesPos.PushBack(ip1 - 1);
-					indicesPos.PushBack(ip2 - 1);
-
-					indicesUV.PushBack(iuv0 - 1);
-					indicesUV.PushBack(iuv1 - 1);
-					indicesUV.PushBack(iuv2 - 1);
-
-					indicesNormal.PushBack(in0 - 1);
-					indicesNormal.PushBack(in1 - 1);
-					indicesNormal.PushBack(in2 - 1);
-				}
-			}
+			vfs::Unmap(&mapping);
+			return true;
+		}
 
-			char* pLineEnd = strchr(pCurrent, '\n');
+		ReleaseBinFile();
 
-			if (pLineEnd)
-				pCurrent = pLineEnd;
+		ObjData obj;
+		bool parsed = obj_parse((const char*)mapping.pData, mapping.size, &obj);
+		vfs::Unmap(&mapping);
 
-			pCurrent++;
+		if (!parsed)
+		{
+			iol_log_error("Failed to parse obj file: '%s'", pFilePath);
+			return false;
 		}
 
-		iol_free(pBuffer);
+		size_t i;
+		size_t numIndices = obj.corners.count;
 
-		Hashmap<MeshVertexKey, MeshVertex> combinations;
-		combinations.Create(GetHashForIndexCombination, 1024 * 1024);
+		// Sized for one combination per position, the map grows if there are more
+		FlatHashmap<MeshVertexKey, MeshVertex> combinations;
+		combinations.Create(obj.positions.count);
 
 		for (i = 0; i < numIndices; i++)
 		{
+			const ObjCorner& corner = obj.corners[i];
+
 			MeshVertexKey key;
-			key.iPos = indicesPos[i];
-			key.iUV = indicesUV[i];
-			key.iNormal = indicesNormal[i];
+			key.iPos = corner.iPos;
+			key.iUV = corner.iUV;
+			key.iNormal = corner.iNormal;
 
+			// Corners without uv or normal get zero
 			MeshVertex vertex;
-			vertex.pos = positions[indicesPos[i]];
-			vertex.uv = uvs[indicesUV[i]];
-			vertex.normal = normals[indicesNormal[i]];
+			vertex.pos = obj.positions[corner.iPos];
+			vertex.uv = corner.iUV != OBJ_INDEX_NONE ? obj.uvs[corner.iUV] : vec2(0.0f);
+			vertex.normal = corner.iNormal != OBJ_INDEX_NONE ? obj.normals[corner.iNormal] : vec3(0.0f);
 			vertex.index = 0; // will be set later
 
 			combinations.Add(key, vertex);
@@ -481,7 +422,7 @@ namespace iol
 		this->indices.Create(numIndices);
 
 		size_t vertexIndex = 0;
-		Hashmap<MeshVertexKey, MeshVertex>::Iterator it;
+		FlatHashmap<MeshVertexKey, MeshVertex>::Iterator it;
 
 		for (it = combinations.GetIterator(); it.IsValid(); it.Increment())
 		{
@@ -496,40 +437,248 @@ namespace iol
 
 		for (i = 0; i < numIndices; i++)
 		{
+			const ObjCorner& corner = obj.corners[i];
+
 			MeshVertexKey key;
-			key.iPos = indicesPos[i];
-			key.iUV = indicesUV[i];
-			key.iNormal = indicesNormal[i];
+			key.iPos = corner.iPos;
+			key.iUV = corner.iUV;
+			key.iNormal = corner.iNormal;
 			MeshVertex* vertex = combinations.Get(key);
 
 			this->indices.PushBack(vertex->index);
 		}
 
+		// A missing cache only costs the next load a parse
+		WriteBinFile(cachePath, sourceHash);
+
 		return true;
 	}
 
-	bool Mesh::WriteBinFile(const char* filePath)
+	static bool mesh_bin_write_block(BinaryWriter& writer, uint64 offset, const void* pData, size_t size)
 	{
-		return false;
+		static const uint8 s_padding[MESH_BIN_ALIGNMENT] = {};
+
+		iol_assert(offset >= writer.GetPosition() && offset - writer.GetPosition() < MESH_BIN_ALIGNMENT);
+
+		writer.WriteBytes(s_padding, (size_t)(offset - writer.GetPosition()));
+		return writer.WriteBytes(pData, size);
 	}
 
-	bool Mesh::LoadBinFile(const char* filePath)
+	bool Mesh::WriteBinFile(const char* pFilePath, uint64 sourceHash)
 	{
-		return false;
+		size_t numVertices = positions.count;
+
+		MeshBinHeader header;
+		memory::FillZero(&header, sizeof(header));
+		header.magic = MESH_BIN_MAGIC;
+		header.version = MESH_BIN_VERSION;
+		header.indexSize = sizeof(uint32);
+		header.sourceHash = sourceHash;
+		header.numVertices = numVertices;
+		header.numIndices = indices.count;
+
+		vec3 boundsMin(0.0f);
+		vec3 boundsMax(0.0f);
+
+		if (numVertices > 0)
+		{
+			boundsMin = positions[0];
+			boundsMax = positions[0];
+		}
+
+		for (size_t i = 1; i < numVertices; i++)
+		{
+			boundsMin = min(boundsMin, positions[i]);
+			boundsMax = max(boundsMax, positions[i]);
+		}
+
+		for (int i = 0; i < 3; i++)
+		{
+			header.boundsMin[i] = boundsMin[i];
+			header.boundsMax[i] = boundsMax[i];
+		}
+
+		// Every block starts aligned, the position block directly behind the header
+		uint64 offset = core::Align(sizeof(MeshBinHeader), MESH_BIN_ALIGNMENT);
+
+		if (numVertices > 0)
+		{
+			header.attributes |= MeshAttributeFlags_Position;
+			header.positionsOffset = offset;
+			offset = core::Align((size_t)offset + sizeof(vec3) * numVertices, MESH_BIN_ALIGNMENT);
+		}
+
+		if (numVertices > 0 && uvs.count == numVertices)
+		{
+			header.attributes |= MeshAttributeFlags_UV;
+			header.uvsOffset = offset;
+			offset = core::Align((size_t)offset + sizeof(vec2) * numVertices, MESH_BIN_ALIGNMENT);
+		}
+
+		if (numVertices > 0 && normals.count == numVertices)
+		{
+			header.attributes |= MeshAttributeFlags_Normal;
+			header.normalsOffset = offset;
+			offset = core::Align((size_t)offset + sizeof(vec3) * numVertices, MESH_BIN_ALIGNMENT);
+		}
+
+		if (indices.count > 0)
+			header.indicesOffset = offset;
+
+		File* pFile = file::Open(pFilePath, FileMode::BinaryWrite);
+
+		if (pFile == nullptr)
+			return false;
+
+		BinaryWriter writer;
+		writer.Create(pFile);
+		writer.Write(header);
+
+		if (header.positionsOffset != 0)
+			mesh_bin_write_block(writer, header.positionsOffset, positions.pData, sizeof(vec3) * numVertices);
+
+		if (header.uvsOffset != 0)
+			mesh_bin_write_block(writer, header.uvsOffset, uvs.pData, sizeof(vec2) * numVertices);
+
+		if (header.normalsOffset != 0)
+			mesh_bin_write_block(writer, header.normalsOffset, normals.pData, sizeof(vec3) * numVertices);
+
+		if (header.indicesOffset != 0)
+			mesh_bin_write_block(writer, header.indicesOffset, indices.pData, sizeof(uint32) * indices.count);
+
+		bool success = writer.Destroy();
+		file::Close(pFile);
+
+		if (!success)
+		{
+			iol_log_error("Failed to write mesh file: '%s'", pFilePath);
+		}
+
+		return success;
 	}
 
-	bool Mesh::GetTrianglesInRadius(glm::vec3 pos, float radius, Array<uint32>& outIndices)
+	bool Mesh::LoadBinFile(const char* pFilePath)
 	{
-		float radiusSqr = radius * radius;
+		return LoadBinFile(pFilePath, 0, true);
+	}
 
-		for (size_t i = 0; i < indices.count; i += 3)
+	// Returns the block or nullptr if it is absent, misaligned or outside of the file
+	static void* mesh_bin_get_block(const FileMapping& mapping, uint64 offset, uint64 count, size_t elementSize)
+	{
+		if (offset == 0 || offset % MESH_BIN_ALIGNMENT != 0 || offset > mapping.size || count > (mapping.size - offset) / elementSize)
+			return nullptr;
+
+		return (void*)(mapping.pData + offset);
+	}
+
+	bool Mesh::LoadBinFile(const char* pFilePath, uint64 sourceHash, bool logErrors)
+	{
+		ReleaseBinFile();
+
+		FileMapping mapping;
+
+		if (!vfs::Map(pFilePath, &mapping))
+		{
+			if (logErrors)
+			{
+				iol_log_error("Failed to load mesh file: '%s'", pFilePath);
+			}
+
+			return false;
+		}
+
+		const MeshBinHeader* pHeader = (const MeshBinHeader*)mapping.pData;
+		bool valid = mapping.size >= sizeof(MeshBinHeader) && pHeader->magic == MESH_BIN_MAGIC && pHeader->version == MESH_BIN_VERSION &&
+			pHeader->indexSize == sizeof(uint32) && (sourceHash == 0 || pHeader->sourceHash == sourceHash);
+
+		size_t numVertices = valid ? (size_t)pHeader->numVertices : 0;
+		size_t numIndices = valid ? (size_t)pHeader->numIndices : 0;
+		vec3* pPositions = nullptr;
+		vec2* pUVs = nullptr;
+		vec3* pNormals = nullptr;
+		uint32* pIndices = nullptr;
+
+		if (valid && (pHeader->attributes & MeshAttributeFlags_Position))
+		{
+			pPositions = (vec3*)mesh_bin_get_block(mapping, pHeader->positionsOffset, numVertices, sizeof(vec3));
+			valid = pPositions != nullptr;
+		}
+
+		if (valid && (pHeader->attributes & MeshAttributeFlags_UV))
+		{
+			pUVs = (vec2*)mesh_bin_get_block(mapping, pHeader->uvsOffset, numVertices, sizeof(vec2));
+			valid = pUVs != nullptr;
+		}
+
+		if (valid && (pHeader->attributes & MeshAttributeFlags_Normal))
 		{
-			if (outIndices.count + 3 >= outIndices.capacity)
+			pNormals = (vec3*)mesh_bin_get_block(mapping, pHeader->normalsOffset, numVertices, sizeof(vec3));
+			valid = pNormals != nullptr;
+		}
+
+		if (valid && numIndices > 0)
+		{
+			pIndices = (uint32*)mesh_bin_get_block(mapping, pHeader->indicesOffset, numIndices, sizeof(uint32));
+			valid = pIndices != nullptr;
+		}
+
+		// A corrupt index would make every later triangle lookup and the GPU upload read out of bounds
+		if (valid && pIndices != nullptr)
+		{
+			size_t numIndexedVertices = pPositions != nullptr ? numVertices : 0;
+
+			for (size_t i = 0; i < numIndices; i++)
 			{
-				iol_log_error("outIndices.capacity is too low!");
-				return true;
+				if (pIndices[i] >= numIndexedVertices)
+				{
+					valid = false;
+					break;
+				}
+			}
+		}
+
+		if (!valid)
+		{
+			if (logErrors)
+			{
+				iol_log_error("Invalid mesh file: '%s'", pFilePath);
 			}
 
+			vfs::Unmap(&mapping);
+			return false;
+		}
+
+		// The arrays point into the read-only mapping
+		positions.CreateView(pPositions, pPositions != nullptr ? numVertices : 0);
+		uvs.CreateView(pUVs, pUVs != nullptr ? numVertices : 0);
+		normals.CreateView(pNormals, pNormals != nullptr ? numVertices : 0);
+		indices.CreateView(pIndices, numIndices);
+		m_binFileMapping = mapping;
+
+		return true;
+	}
+
+	void Mesh::ReleaseBinFile()
+	{
+		if (m_binFileMapping.pData == nullptr)
+			return;
+
+		positions.Destroy();
+		uvs.Destroy();
+		normals.Destroy();
+		indices.Destroy();
+		vfs::Unmap(&m_binFileMapping);
+	}
+
+	bool Mesh::GetTrianglesInRadius(glm::vec3 pos, float radius, BitSet& outTriangles)
+	{
+		iol_assert(outTriangles.numBits == indices.count / 3);
+
+		float radiusSqr = radius * radius;
+		bool found = false;
+
+		for (size_t i = 0; i < indices.count; i += 3)
+		{
 			vec3 v0 = positions[indices[i]];
 			vec3 v1 = positions[indices[i + 1]];
 			vec3 v2 = positions[indices[i + 2]];
@@ -538,28 +687,24 @@ namespace iol
 
 			if (glm::length2(center - pos) < radiusSqr)
 			{
-				outIndices.PushBack(indices[i]);
-				outIndices.PushBack(indices[i + 1]);
-				outIndices.PushBack(indices[i + 2]);
+				outTriangles.Set(i / 3);
+				found = true;
 			}
 		}
 
-		return outIndices.count > 0;
+		return found;
 	}
 
-	bool Mesh::GetTrianglesInRadiusIgnoreHeight(glm::vec3 pos, float radius, Array<uint32>& outIndices)
+	bool Mesh::GetTrianglesInRadiusIgnoreHeight(glm::vec3 pos, float radius, BitSet& outTriangles)
 	{
+		iol_assert(outTriangles.numBits == indices.count / 3);
+
 		float radiusSqr = radius * radius;
+		bool found = false;
 		pos.y = 0.f;
 
 		for (size_t i = 0; i < indices.count; i += 3)
 		{
-			if (outIndices.count + 3 >= outIndices.capacity)
-			{
-				iol_log_error("outIndices.capacity is too low!");
-				return true;
-			}
-
 			vec3 v0 = positions[indices[i]];
 			vec3 v1 = positions[indices[i + 1]];
 			vec3 v2 = positions[indices[i + 2]];
@@ -569,12 +714,11 @@ namespace iol
 
 			if (glm::length2(center - pos) < radiusSqr)
 			{
-				outIndices.PushBack(indices[i]);
-				outIndices.PushBack(indices[i + 1]);
-				outIndices.PushBack(indices[i + 2]);
+				outTriangles.Set(i / 3);
+				found = true;
 			}
 		}
 
-		return outIndices.count > 0;
+		return found;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,491 @@
+#include "mesh_obj.h"
+#include "iol_debug.h"
+#include "iol_core.h"
+#include "iol_memory.h"
+#include "iol_string.h"
+
+#include <math.h>
+
+#define OBJ_MAX_MANTISSA        1000000000000000000ull // further digits don't fit into 64 bits and are dropped
+#define OBJ_MAX_EXACT_MANTISSA  (1ull << 53)
+#define OBJ_MAX_EXACT_EXPONENT  22
+#define OBJ_MAX_EXPONENT        10000
+#define OBJ_INITIAL_CAPACITY    1024
+#define OBJ_INDEX_RELATIVE      0x80000000u // marks negative indices of later chunks, relative to the chunk start
+#define OBJ_RELATIVE_BIAS       0x40000000u
+#define OBJ_INDEX_INVALID       (OBJ_INDEX_NONE - 1) // reaches back before the first attribute, rejected by obj_validate
+
+using namespace glm;
+
+namespace iol
+{
+	struct ObjChunk
+	{
+		uint32 index;
+		const char* pBegin;
+		const char* pEnd;
+		ObjData* pData;
+
+		// Where the chunk's elements start in the merged output
+		size_t positionsBase;
+		size_t uvsBase;
+		size_t normalsBase;
+		size_t cornersBase;
+	};
+
+	struct ObjMergeTask
+	{
+		const ObjChunk* pChunks;
+		ObjData* pOutData;
+	};
+
+	// Powers of ten that are exactly representable as double
+	static const double s_objPowersOfTen[OBJ_MAX_EXACT_EXPONENT + 1] =
+	{
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	iol_inline bool obj_is_digit(char c)
+	{
+		return (uint8)(c - '0') < 10;
+	}
+
+	iol_inline bool obj_is_space(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	iol_inline const char* obj_skip_spaces(const char* p, const char* pEnd)
+	{
+		while (p < pEnd && obj_is_space(*p))
+			p++;
+
+		return p;
+	}
+
+	iol_inline const char* obj_skip_line(const char* p, const char* pEnd)
+	{
+		const char* pNewline = string::Find(StringView(p, (size_t)(pEnd - p)), '\n');
+		return pNewline != nullptr ? pNewline + 1 : pEnd;
+	}
+
+	const char* obj_parse_float(const char* p, const char* pEnd, float* pOutValue)
+	{
+		bool negative = false;
+
+		if (p < pEnd && (*p == '-' || *p == '+'))
+		{
+			negative = *p == '-';
+			p++;
+		}
+
+		uint64 mantissa = 0;
+		int32 exponent = 0;
+		bool hasDigits = false;
+
+		for (; p < pEnd && obj_is_digit(*p); p++)
+		{
+			if (mantissa < OBJ_MAX_MANTISSA)
+				mantissa = mantissa * 10 + (uint64)(*p - '0');
+			else
+				exponent++;
+
+			hasDigits = true;
+		}
+
+		if (p < pEnd && *p == '.')
+		{
+			for (p++; p < pEnd && obj_is_digit(*p); p++)
+			{
+				if (mantissa < OBJ_MAX_MANTISSA)
+				{
+					mantissa = mantissa * 10 + (uint64)(*p - '0');
+					exponent--;
+				}
+
+				hasDigits = true;
+			}
+		}
+
+		if (!hasDigits)
+			return nullptr;
+
+		// 'e' without digits is not part of the number
+		if (p < pEnd && (*p == 'e' || *p == 'E'))
+		{
+			const char* pExponent = p + 1;
+			bool negativeExponent = false;
+
+			if (pExponent < pEnd && (*pExponent == '-' || *pExponent == '+'))
+			{
+				negativeExponent = *pExponent == '-';
+				pExponent++;
+			}
+
+			if (pExponent < pEnd && obj_is_digit(*pExponent))
+			{
+				int32 explicitExponent = 0;
+
+				for (; pExponent < pEnd && obj_is_digit(*pExponent); pExponent++)
+				{
+					if (explicitExponent < OBJ_MAX_EXPONENT)
+						explicitExponent = explicitExponent * 10 + (*pExponent - '0');
+				}
+
+				exponent += negativeExponent ? -explicitExponent : explicitExponent;
+				p = pExponent;
+			}
+		}
+
+		double value = (double)mantissa;
+
+		// Both operands are exact, so the one operation rounds correctly (Clinger's fast path)
+		if (mantissa <= OBJ_MAX_EXACT_MANTISSA && exponent >= -OBJ_MAX_EXACT_EXPONENT && exponent <= OBJ_MAX_EXACT_EXPONENT)
+			value = exponent < 0 ? value / s_objPowersOfTen[-exponent] : value * s_objPowersOfTen[exponent];
+		else if (mantissa != 0)
+			value *= pow(10.0, (double)exponent);
+
+		*pOutValue = (float)(negative ? -value : value);
+
+		return p;
+	}
+
+	const char* obj_parse_int(const char* p, const char* pEnd, int64* pOutValue)
+	{
+		bool negative = false;
+
+		if (p < pEnd && (*p == '-' || *p == '+'))
+		{
+			negative = *p == '-';
+			p++;
+		}
+
+		if (p >= pEnd || !obj_is_digit(*p))
+			return nullptr;
+
+		int64 value = 0;
+
+		// Saturates instead of overflowing, such an index is rejected later anyway
+		for (; p < pEnd && obj_is_digit(*p); p++)
+		{
+			if (value < INT64_MAX / 10)
+				value = value * 10 + (*p - '0');
+		}
+
+		*pOutValue = negative ? -value : value;
+
+		return p;
+	}
+
+	// Parses up to 'maxCount' floats separated by spaces, returns how many were found
+	static uint32 obj_parse_floats(const char** ppText, const char* pEnd, float* pOutValues, uint32 maxCount)
+	{
+		const char* p = *ppText;
+		uint32 count = 0;
+
+		while (count < maxCount)
+		{
+			const char* pNext = obj_parse_float(obj_skip_spaces(p, pEnd), pEnd, &pOutValues[count]);
+
+			if (pNext == nullptr)
+				break;
+
+			p = pNext;
+			count++;
+		}
+
+		*ppText = p;
+		return count;
+	}
+
+	/*
+	* Converts a 1-based or negative OBJ index into a 0-based one, 'count' is the number of attributes the chunk defined so far.
+	* Negative indices in later chunks depend on how many attributes the chunks before define,
+	* they are stored relative to the chunk start and fixed up by obj_merge_chunk.
+	*/
+	static bool obj_parse_index(const char** ppText, const char* pEnd, size_t count, bool firstChunk, uint32* pOutIndex)
+	{
+		int64 index;
+		const char* p = obj_parse_int(*ppText, pEnd, &index);
+
+		if (p == nullptr || index == 0)
+			return false;
+
+		if (index > 0)
+		{
+			if (index > (int64)OBJ_INDEX_RELATIVE)
+				return false;
+
+			*pOutIndex = (uint32)(index - 1);
+		}
+		else
+		{
+			index += (int64)count;
+
+			// Fails the whole file like in later chunks, where this is only known after the merge
+			if (firstChunk)
+			{
+				*pOutIndex = index >= 0 ? (uint32)index : OBJ_INDEX_INVALID;
+			}
+			else
+			{
+				if (index < -(int64)OBJ_RELATIVE_BIAS || index >= (int64)OBJ_RELATIVE_BIAS - 1)
+					return false;
+
+				*pOutIndex = OBJ_INDEX_RELATIVE | (uint32)(index + OBJ_RELATIVE_BIAS);
+			}
+		}
+
+		*ppText = p;
+		return true;
+	}
+
+	// Returns the end of the face, or nullptr if the line is malformed
+	static const char* obj_parse_face(const char* p, const char* pEnd, ObjData* pData, bool firstChunk)
+	{
+		ObjCorner first;
+		ObjCorner previous;
+		uint32 numCorners = 0;
+
+		for (;;)
+		{
+			p = obj_skip_spaces(p, pEnd);
+
+			if (p == pEnd || *p == '\n' || *p == '#')
+				break;
+
+			ObjCorner corner;
+			corner.iUV = OBJ_INDEX_NONE;
+			corner.iNormal = OBJ_INDEX_NONE;
+
+			if (!obj_parse_index(&p, pEnd, pData->positions.count, firstChunk, &corner.iPos))
+				return nullptr;
+
+			if (p < pEnd && *p == '/')
+			{
+				p++;
+
+				if (p < pEnd && *p != '/' && !obj_parse_index(&p, pEnd, pData->uvs.count, firstChunk, &corner.iUV))
+					return nullptr;
+
+				if (p < pEnd && *p == '/')
+				{
+					p++;
+
+					if (!obj_parse_index(&p, pEnd, pData->normals.count, firstChunk, &corner.iNormal))
+						return nullptr;
+				}
+			}
+
+			if (p < pEnd && !obj_is_space(*p) && *p != '\n')
+				return nullptr;
+
+			// Fan triangulation around the first corner
+			if (numCorners == 0)
+			{
+				first = corner;
+			}
+			else if (numCorners >= 2)
+			{
+				pData->corners.PushBack(first);
+				pData->corners.PushBack(previous);
+				pData->corners.PushBack(corner);
+			}
+
+			previous = corner;
+			numCorners++;
+		}
+
+		return p;
+	}
+
+	static void obj_parse_chunk(ObjChunk* pChunk)
+	{
+		ObjData* pData = pChunk->pData;
+		bool firstChunk = pChunk->index == 0;
+
+		pData->positions.CreateGrowable(OBJ_INITIAL_CAPACITY);
+		pData->uvs.CreateGrowable(OBJ_INITIAL_CAPACITY);
+		pData->normals.CreateGrowable(OBJ_INITIAL_CAPACITY);
+		pData->corners.CreateGrowable(OBJ_INITIAL_CAPACITY * 3);
+
+		const char* p = pChunk->pBegin;
+		const char* pEnd = pChunk->pEnd;
+		float values[3];
+
+		while (p < pEnd)
+		{
+			p = obj_skip_spaces(p, pEnd);
+
+			if (p + 1 < pEnd && p[0] == 'v')
+			{
+				if (obj_is_space(p[1]))
+				{
+					p += 2;
+
+					if (obj_parse_floats(&p, pEnd, values, 3) == 3)
+						pData->positions.PushBack(vec3(values[0], values[1], values[2]));
+				}
+				else if (p[1] == 't')
+				{
+					p += 2;
+					values[1] = 0.0f; // 'v' is optional
+
+					if (obj_parse_floats(&p, pEnd, values, 2) >= 1)
+						pData->uvs.PushBack(vec2(values[0], values[1]));
+				}
+				else if (p[1] == 'n')
+				{
+					p += 2;
+
+					if (obj_parse_floats(&p, pEnd, values, 3) == 3)
+						pData->normals.PushBack(vec3(values[0], values[1], values[2]));
+				}
+			}
+			else if (p + 1 < pEnd && p[0] == 'f' && obj_is_space(p[1]))
+			{
+				size_t numCorners = pData->corners.count;
+				const char* pFaceEnd = obj_parse_face(p + 2, pEnd, pData, firstChunk);
+
+				// A malformed face is skipped as a whole
+				if (pFaceEnd == nullptr)
+					pData->corners.count = numCorners;
+				else
+					p = pFaceEnd;
+			}
+
+			p = obj_skip_line(p, pEnd);
+		}
+	}
+
+	iol_inline uint32 obj_resolve_index(uint32 index, size_t base)
+	{
+		if (index == OBJ_INDEX_NONE || (index & OBJ_INDEX_RELATIVE) == 0)
+			return index;
+
+		int64 resolved = (int64)base + (int64)(index & ~OBJ_INDEX_RELATIVE) - (int64)OBJ_RELATIVE_BIAS;
+
+		return resolved >= 0 ? (uint32)resolved : OBJ_INDEX_INVALID;
+	}
+
+	template<typename T>
+	iol_inline void obj_copy_elements(Array<T>& destination, size_t base, const Array<T>& source)
+	{
+		if (source.count > 0)
+			memory::Copy(destination.pData + base, sizeof(T) * source.count, source.pData);
+	}
+
+	// Copies the chunk to its place in the output and fixes up its relative indices
+	static void obj_merge_chunk(const ObjChunk* pChunk, ObjData* pOutData)
+	{
+		const ObjData* pData = pChunk->pData;
+
+		obj_copy_elements(pOutData->positions, pChunk->positionsBase, pData->positions);
+		obj_copy_elements(pOutData->uvs, pChunk->uvsBase, pData->uvs);
+		obj_copy_elements(pOutData->normals, pChunk->normalsBase, pData->normals);
+
+		ObjCorner* pCorners = pOutData->corners.pData + pChunk->cornersBase;
+
+		for (size_t i = 0; i < pData->corners.count; i++)
+		{
+			const ObjCorner& corner = pData->corners[i];
+			pCorners[i].iPos = obj_resolve_index(corner.iPos, pChunk->positionsBase);
+			pCorners[i].iUV = obj_resolve_index(corner.iUV, pChunk->uvsBase);
+			pCorners[i].iNormal = obj_resolve_index(corner.iNormal, pChunk->normalsBase);
+		}
+	}
+
+	static bool obj_validate(const ObjData* pData)
+	{
+		for (size_t i = 0; i < pData->corners.count; i++)
+		{
+			const ObjCorner& corner = pData->corners[i];
+
+			if (corner.iPos >= pData->positions.count ||
+				(corner.iUV != OBJ_INDEX_NONE && corner.iUV >= pData->uvs.count) ||
+				(corner.iNormal != OBJ_INDEX_NONE && corner.iNormal >= pData->normals.count))
+			{
+				iol_log_error("obj face %zu references a vertex attribute that doesn't exist", i / 3);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool obj_parse(const char* pText, size_t size, ObjData* pOutData, uint32 numThreads)
+	{
+		iol_assert(pText != nullptr || size == 0);
+		iol_assert(pOutData != nullptr);
+
+		if (numThreads == 0)
+			numThreads = core::GetHardwareThreadCount();
+
+		uint32 numChunks = (uint32)core::Min<size_t>(core::Min<uint32>(numThreads, CORE_MAX_TASKS), size / OBJ_PARALLEL_MIN_CHUNK_SIZE);
+		const char* pEnd = pText + size;
+
+		if (numChunks <= 1)
+		{
+			ObjChunk chunk;
+			chunk.index = 0;
+			chunk.pBegin = pText;
+			chunk.pEnd = pEnd;
+			chunk.pData = pOutData;
+			obj_parse_chunk(&chunk);
+
+			return obj_validate(pOutData);
+		}
+
+		ObjChunk chunks[CORE_MAX_TASKS];
+		ObjData chunkData[CORE_MAX_TASKS];
+
+		// Chunks of about equal size that end behind a line break
+		for (uint32 i = 0; i < numChunks; i++)
+		{
+			chunks[i].index = i;
+			chunks[i].pBegin = i == 0 ? pText : chunks[i - 1].pEnd;
+			chunks[i].pEnd = i == numChunks - 1 ? pEnd : obj_skip_line(core::Max(pText + size * (i + 1) / numChunks, chunks[i].pBegin), pEnd);
+			chunks[i].pData = &chunkData[i];
+		}
+
+		core::RunTasks(numChunks, [](uint32 taskIndex, void* pUserData) { obj_parse_chunk(&((ObjChunk*)pUserData)[taskIndex]); }, chunks);
+
+		// Prefix sums give every chunk the position of its elements in the output
+		size_t numPositions = 0, numUVs = 0, numNormals = 0, numCorners = 0;
+
+		for (uint32 i = 0; i < numChunks; i++)
+		{
+			chunks[i].positionsBase = numPositions;
+			chunks[i].uvsBase = numUVs;
+			chunks[i].normalsBase = numNormals;
+			chunks[i].cornersBase = numCorners;
+
+			numPositions += chunkData[i].positions.count;
+			numUVs += chunkData[i].uvs.count;
+			numNormals += chunkData[i].normals.count;
+			numCorners += chunkData[i].corners.count;
+		}
+
+		pOutData->positions.Create(numPositions);
+		pOutData->uvs.Create(numUVs);
+		pOutData->normals.Create(numNormals);
+		pOutData->corners.Create(numCorners);
+		pOutData->positions.count = numPositions;
+		pOutData->uvs.count = numUVs;
+		pOutData->normals.count = numNormals;
+		pOutData->corners.count = numCorners;
+
+		ObjMergeTask merge;
+		merge.pChunks = chunks;
+		merge.pOutData = pOutData;
+
+		core::RunTasks(numChunks, [](uint32 taskIndex, void* pUserData)
+		{
+			ObjMergeTask* pMerge = (ObjMergeTask*)pUserData;
+			obj_merge_chunk(&pMerge->pChunks[taskIndex], pMerge->pOutData);
+		}, &merge);
+
+		return obj_validate(pOutData);
+	}
+}
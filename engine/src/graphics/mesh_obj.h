@@ -0,0 +1,49 @@
+#ifndef IOLITE_MESH_OBJ_H
+#define IOLITE_MESH_OBJ_H
+
+#include "iol_definitions.h"
+#include "iol_array.h"
+
+#define OBJ_INDEX_NONE               0xFFFFFFFFu // the face corner has no uv or normal
+#define OBJ_PARALLEL_MIN_CHUNK_SIZE  (1024 * 1024) // bytes of text each thread parses at least before obj_parse uses another thread
+
+namespace iol
+{
+	struct ObjCorner
+	{
+		uint32 iPos;
+		uint32 iUV;
+		uint32 iNormal;
+	};
+
+	/*
+	* Vertex attributes and triangle corners of an OBJ file, three corners per triangle.
+	* Corner indices are 0-based and already resolved from negative (relative) OBJ indices.
+	*/
+	struct ObjData
+	{
+		Array<glm::vec3> positions;
+		Array<glm::vec2> uvs;
+		Array<glm::vec3> normals;
+		Array<ObjCorner> corners;
+	};
+
+	/*
+	* Single pass parser for 'v', 'vt', 'vn' and 'f' lines, every other line is ignored.
+	* Faces may use the v, v/vt, v//vn and v/vt/vn forms, quads and n-gons are triangulated as fans.
+	* Fails if a face references an attribute that doesn't exist.
+	* Large files are split at line breaks into one chunk per thread, 0 threads uses every hardware thread.
+	* The chunks are parsed in parallel and merged with prefix sums over their attribute counts, so the result doesn't depend on the number of threads.
+	*/
+	bool         obj_parse(const char* pText, size_t size, ObjData* pOutData, uint32 numThreads = 0);
+
+	/*
+	* Locale independent number parsers, return the end of the number or nullptr if there is none at pText.
+	* Floats with a mantissa below 2^53 and a decimal exponent within +-22 are converted with one exactly rounded double operation,
+	* everything else is scaled with pow() and may be off by an ulp.
+	*/
+	const char*  obj_parse_float(const char* pText, const char* pEnd, float* pOutValue);
+	const char*  obj_parse_int(const char* pText, const char* pEnd, int64* pOutValue);
+}
+
+#endif // IOLITE_MESH_OBJ_H
@@ -1,5 +1,7 @@
 #include "iol_string.h"
+#include "string_internal.h"
 #include "iol_debug.h"
+#include "iol_hash.h"
 #include <string.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -16,38 +18,23 @@ namespace iol
 	{
 		iol_assert(pString);
 
-		uint32 hash = 0;
-
-		const char* pCurrent = pString;
-		while (*pCurrent)
-		{
-			uint8 current = (uint8)(*pCurrent);
-			hash = (hash + current * 47) ^ 151;
-			++pCurrent;
-		}
-
-		return hash;
+		return (uint32)hash::String(pString);
 	}
 
 	size_t string::GetLength(const char* pString)
 	{
 		iol_assert(pString);
 
-		size_t length = 0;
-		while (*pString++)
-		{
-			++length;
-		}
+		static const StringCharSet s_terminator = string_create_char_set("", 1);
 
-		return length;
+		return string_scan(pString, nullptr, s_terminator, false) - pString;
 	}
 
 	const char* string::GetNextLine(const char* pString)
 	{
-		while (*pString && *pString != '\n')
-		{
-			++pString;
-		}
+		static const StringCharSet s_lineEnd = string_create_char_set("\n", 2);
+
+		pString = string_scan(pString, nullptr, s_lineEnd, false);
 
 		if (*pString)
 		{
@@ -59,10 +46,9 @@ namespace iol
 
 	char* string::GetNextLine(char* pString)
 	{
-		while (*pString && *pString != '\n')
-		{
-			++pString;
-		}
+		static const StringCharSet s_lineEnd = string_create_char_set("\n", 2);
+
+		pString = (char*)string_scan(pString, nullptr, s_lineEnd, false);
 
 		if (*pString)
 		{
@@ -152,54 +138,37 @@ namespace iol
 		iol_assert(pCharactersToRemove);
 		iol_assert(pOutStringBuffer);
 
+		// The terminator is part of the set, so every scan stops at the end of the string
+		StringCharSet set = string_create_char_set(pCharactersToRemove, strlen(pCharactersToRemove) + 1);
+
 		const char* pCurrent = pSourceString;
-		size_t outIndex = 0;
-		while (*pCurrent)
+		char* pOut = pOutStringBuffer;
+
+		for (;;)
 		{
-			bool remove = false;
-			const char* pCurrentCharToRemove = pCharactersToRemove;
-			while (*pCurrentCharToRemove)
-			{
-				if (*pCurrentCharToRemove == *pCurrent)
-				{
-					remove = true;
-					break;
-				}
-				++pCurrentCharToRemove;
-			}
-			if (!remove)
-			{
-				pOutStringBuffer[outIndex] = *pCurrent;
-				++outIndex;
-			}
+			const char* pRunEnd = string_scan(pCurrent, nullptr, set, false);
+			size_t runLength = pRunEnd - pCurrent;
+
+			// The buffers may be the same, the output never gets ahead of the input
+			memmove(pOut, pCurrent, runLength);
+			pOut += runLength;
 
-			++pCurrent;
+			if (*pRunEnd == 0)
+				break;
+
+			pCurrent = pRunEnd + 1;
 		}
 
-		pOutStringBuffer[outIndex] = '\0';
+		*pOut = '\0';
 	}
 
 	char* string::ReplaceCharacters(char* pString, const char* pCharactersToReplace, char replacementCharacter)
 	{
-		char* pCurrent = pString;
-
-		while (*pCurrent)
-		{
-			const char* pReplaceChar = pCharactersToReplace;
-
-			while (*pReplaceChar)
-			{
-				if (*pCurrent == *pReplaceChar)
-				{
-					*pCurrent = replacementCharacter;
-					break;
-				}
-
-				pReplaceChar++;
-			}
+		iol_assert(pString);
+		iol_assert(pCharactersToReplace);
 
-			pCurrent++;
-		}
+		StringCharSet set = string_create_char_set(pCharactersToReplace);
+		string_replace(pString, pString + string::GetLength(pString), set, replacementCharacter);
 
 		return pString;
 	}
@@ -249,54 +218,26 @@ namespace iol
 
 	const char* string::Skip(const char* pString, const char* charsToSkip)
 	{
-		while (pString && *pString)
-		{
-			bool skip = false;
-
-			while (*charsToSkip)
-			{
-				if (*charsToSkip == *pString)
-				{
-					skip = true;
-					break;
-				}
-
-				charsToSkip++;
-			}
+		if (pString == nullptr)
+			return nullptr;
 
-			if (!skip)
-				return pString;
+		iol_assert(charsToSkip);
 
-			pString++;
-		}
+		StringCharSet set = string_create_char_set(charsToSkip);
 
-		return pString;
+		return (const char*)string_scan(pString, nullptr, set, true);
 	}
 
 	char* string::Skip(char* pString, const char* charsToSkip)
 	{
-		while (pString && *pString)
-		{
-			bool skip = false;
-
-			while (*charsToSkip)
-			{
-				if (*charsToSkip == *pString)
-				{
-					skip = true;
-					break;
-				}
-
-				charsToSkip++;
-			}
+		if (pString == nullptr)
+			return nullptr;
 
-			if (!skip)
-				return pString;
+		iol_assert(charsToSkip);
 
-			pString++;
-		}
+		StringCharSet set = string_create_char_set(charsToSkip);
 
-		return pString;
+		return (char*)string_scan(pString, nullptr, set, true);
 	}
 
 	char* string::SubstringAlloc(const char* pStart, const char* pEnd)
@@ -335,4 +276,184 @@ namespace iol
 
 		return pResult;
 	}
+	StringView::StringView(const char* pString)
+		: pData(pString), length(pString ? strlen(pString) : 0)
+	{
+	}
+
+	StringView string::CreateView(const char* pStart, const char* pEnd)
+	{
+		iol_assert(pStart <= pEnd);
+
+		return StringView(pStart, pEnd - pStart);
+	}
+
+	StringView string::Substring(StringView view, size_t start, size_t length)
+	{
+		if (start > view.length)
+			start = view.length;
+
+		if (length > view.length - start)
+			length = view.length - start;
+
+		return StringView(view.pData + start, length);
+	}
+
+	StringView string::GetNextLine(StringView view)
+	{
+		const char* pLineEnd = string::Find(view, '\n');
+
+		if (pLineEnd == nullptr)
+			return StringView(view.GetEnd(), 0);
+
+		return string::CreateView(pLineEnd + 1, view.GetEnd());
+	}
+
+	StringView string::SplitLine(StringView* pView)
+	{
+		StringView line = string::Split(pView, '\n');
+
+		if (line.length > 0 && line[line.length - 1] == '\r')
+			line.length--;
+
+		return line;
+	}
+
+	StringView string::Split(StringView* pView, char delimiter)
+	{
+		iol_assert(pView);
+
+		const char* pDelimiter = string::Find(*pView, delimiter);
+
+		if (pDelimiter == nullptr)
+		{
+			StringView result = *pView;
+			*pView = StringView(pView->GetEnd(), 0);
+			return result;
+		}
+
+		StringView result = string::CreateView(pView->pData, pDelimiter);
+		*pView = string::CreateView(pDelimiter + 1, pView->GetEnd());
+
+		return result;
+	}
+
+	const char* string::Find(StringView view, StringView toFind)
+	{
+		if (toFind.length == 0)
+			return view.pData;
+
+		if (toFind.length > view.length)
+			return nullptr;
+
+		const char* pCurrent = view.pData;
+		const char* pLast = view.GetEnd() - toFind.length;
+
+		while (pCurrent <= pLast)
+		{
+			pCurrent = (const char*)memchr(pCurrent, toFind[0], pLast - pCurrent + 1);
+
+			if (pCurrent == nullptr)
+				return nullptr;
+
+			if (memcmp(pCurrent, toFind.pData, toFind.length) == 0)
+				return pCurrent;
+
+			pCurrent++;
+		}
+
+		return nullptr;
+	}
+
+	const char* string::Find(StringView view, char character)
+	{
+		if (view.length == 0)
+			return nullptr;
+
+		StringCharSet set = string_create_char_set(&character, 1);
+		const char* pFound = string_scan(view.pData, view.GetEnd(), set, false);
+
+		return pFound != view.GetEnd() ? pFound : nullptr;
+	}
+
+	const char* string::FindReverse(StringView view, StringView toFind)
+	{
+		if (toFind.length > view.length)
+			return nullptr;
+
+		const char* pCurrent = view.GetEnd() - toFind.length;
+
+		for (;;)
+		{
+			if (memcmp(pCurrent, toFind.pData, toFind.length) == 0)
+				return pCurrent;
+
+			if (pCurrent == view.pData)
+				return nullptr;
+
+			pCurrent--;
+		}
+	}
+
+	bool string::Contains(StringView view, StringView toFind)
+	{
+		return string::Find(view, toFind) != nullptr;
+	}
+
+	bool string::Equals(StringView view0, StringView view1)
+	{
+		return view0.length == view1.length && memcmp(view0.pData, view1.pData, view0.length) == 0;
+	}
+
+	bool string::StartsWith(StringView view, StringView prefix)
+	{
+		return view.length >= prefix.length && memcmp(view.pData, prefix.pData, prefix.length) == 0;
+	}
+
+	bool string::EndsWith(StringView view, StringView suffix)
+	{
+		return view.length >= suffix.length && memcmp(view.GetEnd() - suffix.length, suffix.pData, suffix.length) == 0;
+	}
+
+	StringView string::Skip(StringView view, const char* charsToSkip)
+	{
+		iol_assert(charsToSkip);
+
+		if (view.length == 0)
+			return view;
+
+		StringCharSet set = string_create_char_set(charsToSkip);
+
+		return string::CreateView(string_scan(view.pData, view.GetEnd(), set, true), view.GetEnd());
+	}
+
+	StringView string::TrimEnd(StringView view, const char* charsToTrim)
+	{
+		iol_assert(charsToTrim);
+
+		while (view.length > 0 && view[view.length - 1] != 0 && strchr(charsToTrim, view[view.length - 1]))
+		{
+			view.length--;
+		}
+
+		return view;
+	}
+
+	StringView string::Trim(StringView view, const char* charsToTrim)
+	{
+		return string::TrimEnd(string::Skip(view, charsToTrim), charsToTrim);
+	}
+
+	char* string::Copy(char* pStringBuffer, StringView view, size_t capacity)
+	{
+		iol_assert(pStringBuffer);
+		iol_assert(view.length < capacity);
+
+		if (view.length > 0)
+			memory::Copy(pStringBuffer, view.length, view.pData);
+
+		pStringBuffer[view.length] = 0;
+
+		return pStringBuffer;
+	}
 }
\ No newline at end of file
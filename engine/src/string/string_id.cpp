@@ -0,0 +1,206 @@
+#include "iol_string_id.h"
+#include "iol_flat_hashmap.h"
+#include "iol_virtual_array.h"
+#include "iol_memory.h"
+#include "iol_core.h"
+#include "iol_debug.h"
+#include <string.h>
+#include <mutex>
+#include <atomic>
+
+namespace iol
+{
+	struct StringIdEntry
+	{
+		const char* pString;
+		size_t length;
+		uint64 hash;
+	};
+
+	// Points either into the string storage or at the caller's string during a lookup
+	struct StringIdKey
+	{
+		const char* pString;
+		size_t length;
+		uint64 hash;
+
+		bool operator==(const StringIdKey& other) const
+		{
+			return hash == other.hash && length == other.length && memcmp(pString, other.pString, length) == 0;
+		}
+	};
+
+	template<>
+	struct Hash<StringIdKey>
+	{
+		static uint32 Get(const StringIdKey& key)
+		{
+			return (uint32)key.hash;
+		}
+	};
+
+	struct StringIdChunk
+	{
+		StringIdChunk* pNext;
+		size_t capacity;
+		size_t used;
+	};
+
+	struct StringIdSystem
+	{
+		std::mutex mutex;
+		FlatHashmap<StringIdKey, uint32> lookup;
+		VirtualArray<StringIdEntry> entries; // index is id - 1, addresses are stable so GetString() needs no lock
+		StringIdChunk* pChunks;
+		std::atomic<uint32> numPublished; // entries.count, stored after the entry is written so asserts can read it without the lock
+	};
+
+	static StringIdSystem* s_pSystem = nullptr;
+
+	static const char* string_id_store(const char* pString, size_t length)
+	{
+		StringIdChunk* pChunk = s_pSystem->pChunks;
+
+		if (pChunk == nullptr || pChunk->used + length + 1 > pChunk->capacity)
+		{
+			// Strings that don't fit into a regular chunk get a chunk of their own
+			size_t capacity = core::Max<size_t>(STRING_ID_CHUNK_SIZE, sizeof(StringIdChunk) + length + 1);
+			pChunk = (StringIdChunk*)iol_alloc_raw(capacity);
+			pChunk->pNext = s_pSystem->pChunks;
+			pChunk->capacity = capacity;
+			pChunk->used = sizeof(StringIdChunk);
+			s_pSystem->pChunks = pChunk;
+		}
+
+		char* pStored = (char*)pChunk + pChunk->used;
+		memcpy(pStored, pString, length);
+		pStored[length] = 0;
+		pChunk->used += length + 1;
+
+		return pStored;
+	}
+
+	void string_id::CreateSystem()
+	{
+		iol_assert(s_pSystem == nullptr);
+
+		s_pSystem = iol_new(StringIdSystem);
+		s_pSystem->lookup.Create(1024);
+		s_pSystem->entries.Create(STRING_ID_MAX_COUNT);
+		s_pSystem->pChunks = nullptr;
+		s_pSystem->numPublished.store(0, std::memory_order_relaxed);
+	}
+
+	void string_id::DestroySystem()
+	{
+		iol_assert(s_pSystem != nullptr);
+
+		StringIdChunk* pChunk = s_pSystem->pChunks;
+
+		while (pChunk)
+		{
+			StringIdChunk* pNext = pChunk->pNext;
+			iol_free(pChunk);
+			pChunk = pNext;
+		}
+
+		s_pSystem->lookup.Destroy();
+		s_pSystem->entries.Destroy();
+		iol_delete(s_pSystem);
+	}
+
+	StringId string_id::Intern(const char* pString)
+	{
+		iol_assert(pString != nullptr);
+
+		return Intern(pString, strlen(pString));
+	}
+
+	StringId string_id::Intern(const char* pString, size_t length)
+	{
+		iol_assert(s_pSystem != nullptr);
+		iol_assert(pString != nullptr || length == 0);
+
+		StringIdKey key;
+		key.pString = pString;
+		key.length = length;
+		key.hash = hash::String(pString, length);
+
+		std::lock_guard<std::mutex> lock(s_pSystem->mutex);
+
+		uint32* pValue = s_pSystem->lookup.Get(key);
+
+		if (pValue != nullptr)
+			return StringId{ *pValue };
+
+		if (s_pSystem->entries.IsFull())
+		{
+			iol_log_error("too many interned strings! max: %zu", (size_t)STRING_ID_MAX_COUNT);
+			iol_assert(false);
+			return StringId{ 0 };
+		}
+
+		key.pString = string_id_store(pString, length);
+
+		StringIdEntry& entry = s_pSystem->entries.PushBack();
+		entry.pString = key.pString;
+		entry.length = length;
+		entry.hash = key.hash;
+
+		uint32 value = (uint32)s_pSystem->entries.count;
+		s_pSystem->lookup.Add(key, value);
+		s_pSystem->numPublished.store(value, std::memory_order_release);
+
+		return StringId{ value };
+	}
+
+	StringId string_id::Find(const char* pString)
+	{
+		iol_assert(s_pSystem != nullptr);
+		iol_assert(pString != nullptr);
+
+		StringIdKey key;
+		key.pString = pString;
+		key.length = strlen(pString);
+		key.hash = hash::String(pString, key.length);
+
+		std::lock_guard<std::mutex> lock(s_pSystem->mutex);
+
+		uint32* pValue = s_pSystem->lookup.Get(key);
+
+		return StringId{ pValue ? *pValue : 0 };
+	}
+
+	const char* string_id::GetString(StringId id)
+	{
+		iol_assert(s_pSystem != nullptr);
+		iol_assert(id.IsValid() && id.value <= s_pSystem->numPublished.load(std::memory_order_acquire));
+
+		return s_pSystem->entries.pData[id.value - 1].pString;
+	}
+
+	size_t string_id::GetLength(StringId id)
+	{
+		iol_assert(s_pSystem != nullptr);
+		iol_assert(id.IsValid() && id.value <= s_pSystem->numPublished.load(std::memory_order_acquire));
+
+		return s_pSystem->entries.pData[id.value - 1].length;
+	}
+
+	uint64 string_id::GetHash(StringId id)
+	{
+		iol_assert(s_pSystem != nullptr);
+		iol_assert(id.IsValid() && id.value <= s_pSystem->numPublished.load(std::memory_order_acquire));
+
+		return s_pSystem->entries.pData[id.value - 1].hash;
+	}
+
+	size_t string_id::GetCount()
+	{
+		iol_assert(s_pSystem != nullptr);
+
+		std::lock_guard<std::mutex> lock(s_pSystem->mutex);
+
+		return s_pSystem->entries.count;
+	}
+}
\ No newline at end of file
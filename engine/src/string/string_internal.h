@@ -0,0 +1,37 @@
+#ifndef IOLITE_STRING_INTERNAL_H
+#define IOLITE_STRING_INTERNAL_H
+
+#include "iol_definitions.h"
+
+#define STRING_CHAR_SET_MAX_SIZE 16
+
+namespace iol
+{
+	/*
+	* Sets of up to STRING_CHAR_SET_MAX_SIZE characters are scanned with SIMD compares against 'chars',
+	* larger sets fall back to a scalar scan over the bit table.
+	*/
+	struct StringCharSet
+	{
+		char chars[STRING_CHAR_SET_MAX_SIZE];
+		uint32 count;
+		uint32 bits[256 / 32];
+	};
+
+	/* pChars may contain the null terminator when an explicit count is given, there is no limit on the count. */
+	StringCharSet  string_create_char_set(const char* pChars);
+	StringCharSet  string_create_char_set(const char* pChars, size_t count);
+
+	/*
+	* Returns the first character in [pString, pEnd) that is in the set, or with invert set the first one that is not.
+	* Returns pEnd if there is none. With pEnd == nullptr the scan runs until it finds a match,
+	* so the set has to contain the null terminator or invert has to be set.
+	* Uses AVX2 if the CPU supports it, otherwise SSE2 or NEON.
+	*/
+	const char*    string_scan(const char* pString, const char* pEnd, const StringCharSet& set, bool invert);
+
+	/* Replaces every character in [pString, pEnd) that is in the set. */
+	void           string_replace(char* pString, char* pEnd, const StringCharSet& set, char replacement);
+}
+
+#endif // IOLITE_STRING_INTERNAL_H
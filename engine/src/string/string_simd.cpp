@@ -0,0 +1,414 @@
+#include "string_internal.h"
+#include "iol_core.h"
+#include "iol_debug.h"
+#include <string.h>
+
+#if defined(IOL_SIMD_SSE2)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define STRING_TARGET_AVX2
+#else
+#define STRING_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(IOL_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+* Scans without an end pointer load whole aligned blocks, which may read past the null terminator.
+* An aligned load never crosses a page boundary, so those bytes are always readable and get masked out.
+* AddressSanitizer can't know that and would report the read, so it is disabled for the scan kernels.
+*/
+#if defined(_MSC_VER)
+#define STRING_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#else
+#define STRING_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#endif
+
+namespace iol
+{
+	typedef const char* (*StringScanFunction)(const char* pString, const char* pEnd, const StringCharSet& set, bool invert);
+	typedef void (*StringReplaceFunction)(char* pString, char* pEnd, const StringCharSet& set, char replacement);
+
+	struct StringSimdFunctions
+	{
+		StringScanFunction scan;
+		StringReplaceFunction replace;
+	};
+
+	static iol_inline bool string_in_set(char c, const StringCharSet& set)
+	{
+		uint8 value = (uint8)c;
+		return (set.bits[value >> 5] >> (value & 31)) & 1;
+	}
+
+	static const char* string_scan_scalar(const char* pString, const char* pEnd, const StringCharSet& set, bool invert)
+	{
+		if (pEnd == nullptr)
+		{
+			while (string_in_set(*pString, set) == invert)
+				pString++;
+
+			return pString;
+		}
+
+		while (pString < pEnd && string_in_set(*pString, set) == invert)
+			pString++;
+
+		return pString;
+	}
+
+	static void string_replace_scalar(char* pString, char* pEnd, const StringCharSet& set, char replacement)
+	{
+		for (; pString < pEnd; pString++)
+		{
+			if (string_in_set(*pString, set))
+				*pString = replacement;
+		}
+	}
+
+#if defined(IOL_SIMD_SSE2)
+	static iol_inline uint32 string_match_sse2(__m128i block, const __m128i* pChars, uint32 count)
+	{
+		__m128i match = _mm_setzero_si128();
+
+		for (uint32 i = 0; i < count; i++)
+			match = _mm_or_si128(match, _mm_cmpeq_epi8(block, pChars[i]));
+
+		return (uint32)_mm_movemask_epi8(match);
+	}
+
+	static STRING_NO_SANITIZE_ADDRESS const char* string_scan_sse2(const char* pString, const char* pEnd, const StringCharSet& set, bool invert)
+	{
+		__m128i chars[STRING_CHAR_SET_MAX_SIZE];
+
+		for (uint32 i = 0; i < set.count; i++)
+			chars[i] = _mm_set1_epi8(set.chars[i]);
+
+		uint32 invertMask = invert ? 0xFFFF : 0;
+
+		if (pEnd == nullptr)
+		{
+			const char* pBlock = (const char*)((uintptr_t)pString & ~(uintptr_t)15);
+			uint32 mask = string_match_sse2(_mm_load_si128((const __m128i*)pBlock), chars, set.count) ^ invertMask;
+			mask &= 0xFFFFu << (pString - pBlock);
+
+			while (mask == 0)
+			{
+				pBlock += 16;
+				mask = string_match_sse2(_mm_load_si128((const __m128i*)pBlock), chars, set.count) ^ invertMask;
+			}
+
+			return pBlock + core::CountTrailingZeros(mask);
+		}
+
+		if (pEnd - pString < 16)
+			return string_scan_scalar(pString, pEnd, set, invert);
+
+		for (; pEnd - pString >= 16; pString += 16)
+		{
+			uint32 mask = string_match_sse2(_mm_loadu_si128((const __m128i*)pString), chars, set.count) ^ invertMask;
+
+			if (mask != 0)
+				return pString + core::CountTrailingZeros(mask);
+		}
+
+		// The last block overlaps bytes that were already checked
+		pString = pEnd - 16;
+		uint32 mask = string_match_sse2(_mm_loadu_si128((const __m128i*)pString), chars, set.count) ^ invertMask;
+
+		return mask != 0 ? pString + core::CountTrailingZeros(mask) : pEnd;
+	}
+
+	static void string_replace_sse2(char* pString, char* pEnd, const StringCharSet& set, char replacement)
+	{
+		if (pEnd - pString < 16)
+		{
+			string_replace_scalar(pString, pEnd, set, replacement);
+			return;
+		}
+
+		__m128i replacementVec = _mm_set1_epi8(replacement);
+		char* pLast = pEnd - 16;
+
+		for (;;)
+		{
+			__m128i block = _mm_loadu_si128((const __m128i*)pString);
+			__m128i match = _mm_setzero_si128();
+
+			for (uint32 i = 0; i < set.count; i++)
+				match = _mm_or_si128(match, _mm_cmpeq_epi8(block, _mm_set1_epi8(set.chars[i])));
+
+			block = _mm_or_si128(_mm_andnot_si128(match, block), _mm_and_si128(match, replacementVec));
+			_mm_storeu_si128((__m128i*)pString, block);
+
+			if (pString == pLast)
+				break;
+
+			// Replacing twice gives the same result, so the last block may overlap
+			pString = (pLast - pString >= 16) ? pString + 16 : pLast;
+		}
+	}
+
+	static iol_inline STRING_TARGET_AVX2 uint32 string_match_avx2(__m256i block, const __m256i* pChars, uint32 count)
+	{
+		__m256i match = _mm256_setzero_si256();
+
+		for (uint32 i = 0; i < count; i++)
+			match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, pChars[i]));
+
+		return (uint32)_mm256_movemask_epi8(match);
+	}
+
+	static STRING_TARGET_AVX2 STRING_NO_SANITIZE_ADDRESS const char* string_scan_avx2(const char* pString, const char* pEnd, const StringCharSet& set, bool invert)
+	{
+		__m256i chars[STRING_CHAR_SET_MAX_SIZE];
+
+		for (uint32 i = 0; i < set.count; i++)
+			chars[i] = _mm256_set1_epi8(set.chars[i]);
+
+		uint32 invertMask = invert ? 0xFFFFFFFF : 0;
+
+		if (pEnd == nullptr)
+		{
+			const char* pBlock = (const char*)((uintptr_t)pString & ~(uintptr_t)31);
+			uint32 mask = string_match_avx2(_mm256_load_si256((const __m256i*)pBlock), chars, set.count) ^ invertMask;
+			mask &= 0xFFFFFFFFu << (pString - pBlock);
+
+			while (mask == 0)
+			{
+				pBlock += 32;
+				mask = string_match_avx2(_mm256_load_si256((const __m256i*)pBlock), chars, set.count) ^ invertMask;
+			}
+
+			return pBlock + core::CountTrailingZeros(mask);
+		}
+
+		if (pEnd - pString < 32)
+			return string_scan_sse2(pString, pEnd, set, invert);
+
+		for (; pEnd - pString >= 32; pString += 32)
+		{
+			uint32 mask = string_match_avx2(_mm256_loadu_si256((const __m256i*)pString), chars, set.count) ^ invertMask;
+
+			if (mask != 0)
+				return pString + core::CountTrailingZeros(mask);
+		}
+
+		pString = pEnd - 32;
+		uint32 mask = string_match_avx2(_mm256_loadu_si256((const __m256i*)pString), chars, set.count) ^ invertMask;
+
+		return mask != 0 ? pString + core::CountTrailingZeros(mask) : pEnd;
+	}
+
+	static STRING_TARGET_AVX2 void string_replace_avx2(char* pString, char* pEnd, const StringCharSet& set, char replacement)
+	{
+		if (pEnd - pString < 32)
+		{
+			string_replace_sse2(pString, pEnd, set, replacement);
+			return;
+		}
+
+		__m256i replacementVec = _mm256_set1_epi8(replacement);
+		char* pLast = pEnd - 32;
+
+		for (;;)
+		{
+			__m256i block = _mm256_loadu_si256((const __m256i*)pString);
+			__m256i match = _mm256_setzero_si256();
+
+			for (uint32 i = 0; i < set.count; i++)
+				match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(set.chars[i])));
+
+			_mm256_storeu_si256((__m256i*)pString, _mm256_blendv_epi8(block, replacementVec, match));
+
+			if (pString == pLast)
+				break;
+
+			pString = (pLast - pString >= 32) ? pString + 32 : pLast;
+		}
+	}
+
+	static bool string_cpu_supports_avx2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+
+		if (info[0] < 7)
+			return false;
+
+		// AVX2 also needs the OS to save the YMM registers
+		__cpuid(info, 1);
+		bool osSavesYmm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+
+		__cpuidex(info, 7, 0);
+		return osSavesYmm && (info[1] & (1 << 5));
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#elif defined(IOL_SIMD_NEON)
+	// 4 bits per byte, NEON has no movemask
+	static iol_inline uint64 string_match_neon(uint8x16_t block, const uint8x16_t* pChars, uint32 count)
+	{
+		uint8x16_t match = vdupq_n_u8(0);
+
+		for (uint32 i = 0; i < count; i++)
+			match = vorrq_u8(match, vceqq_u8(block, pChars[i]));
+
+		return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+	}
+
+	static STRING_NO_SANITIZE_ADDRESS const char* string_scan_neon(const char* pString, const char* pEnd, const StringCharSet& set, bool invert)
+	{
+		uint8x16_t chars[STRING_CHAR_SET_MAX_SIZE];
+
+		for (uint32 i = 0; i < set.count; i++)
+			chars[i] = vdupq_n_u8((uint8)set.chars[i]);
+
+		uint64 invertMask = invert ? ~0ull : 0;
+
+		if (pEnd == nullptr)
+		{
+			const char* pBlock = (const char*)((uintptr_t)pString & ~(uintptr_t)15);
+			uint64 mask = string_match_neon(vld1q_u8((const uint8*)pBlock), chars, set.count) ^ invertMask;
+			mask &= ~0ull << ((pString - pBlock) * 4);
+
+			while (mask == 0)
+			{
+				pBlock += 16;
+				mask = string_match_neon(vld1q_u8((const uint8*)pBlock), chars, set.count) ^ invertMask;
+			}
+
+			return pBlock + core::CountTrailingZeros(mask) / 4;
+		}
+
+		if (pEnd - pString < 16)
+			return string_scan_scalar(pString, pEnd, set, invert);
+
+		for (; pEnd - pString >= 16; pString += 16)
+		{
+			uint64 mask = string_match_neon(vld1q_u8((const uint8*)pString), chars, set.count) ^ invertMask;
+
+			if (mask != 0)
+				return pString + core::CountTrailingZeros(mask) / 4;
+		}
+
+		// The last block overlaps bytes that were already checked
+		pString = pEnd - 16;
+		uint64 mask = string_match_neon(vld1q_u8((const uint8*)pString), chars, set.count) ^ invertMask;
+
+		return mask != 0 ? pString + core::CountTrailingZeros(mask) / 4 : pEnd;
+	}
+
+	static void string_replace_neon(char* pString, char* pEnd, const StringCharSet& set, char replacement)
+	{
+		if (pEnd - pString < 16)
+		{
+			string_replace_scalar(pString, pEnd, set, replacement);
+			return;
+		}
+
+		uint8x16_t replacementVec = vdupq_n_u8((uint8)replacement);
+		char* pLast = pEnd - 16;
+
+		for (;;)
+		{
+			uint8x16_t block = vld1q_u8((const uint8*)pString);
+			uint8x16_t match = vdupq_n_u8(0);
+
+			for (uint32 i = 0; i < set.count; i++)
+				match = vorrq_u8(match, vceqq_u8(block, vdupq_n_u8((uint8)set.chars[i])));
+
+			vst1q_u8((uint8*)pString, vbslq_u8(match, replacementVec, block));
+
+			if (pString == pLast)
+				break;
+
+			// Replacing twice gives the same result, so the last block may overlap
+			pString = (pLast - pString >= 16) ? pString + 16 : pLast;
+		}
+	}
+#endif
+
+	static StringSimdFunctions string_select_functions()
+	{
+		StringSimdFunctions functions;
+
+#if defined(IOL_SIMD_SSE2)
+		if (string_cpu_supports_avx2())
+		{
+			functions.scan = string_scan_avx2;
+			functions.replace = string_replace_avx2;
+		}
+		else
+		{
+			functions.scan = string_scan_sse2;
+			functions.replace = string_replace_sse2;
+		}
+#elif defined(IOL_SIMD_NEON)
+		functions.scan = string_scan_neon;
+		functions.replace = string_replace_neon;
+#else
+		functions.scan = string_scan_scalar;
+		functions.replace = string_replace_scalar;
+#endif
+
+		return functions;
+	}
+
+	static const StringSimdFunctions& string_get_functions()
+	{
+		static const StringSimdFunctions s_functions = string_select_functions();
+		return s_functions;
+	}
+
+	StringCharSet string_create_char_set(const char* pChars)
+	{
+		return string_create_char_set(pChars, strlen(pChars));
+	}
+
+	StringCharSet string_create_char_set(const char* pChars, size_t count)
+	{
+		StringCharSet set;
+		set.count = (uint32)count;
+		memset(set.bits, 0, sizeof(set.bits));
+
+		for (size_t i = 0; i < count; i++)
+		{
+			uint8 value = (uint8)pChars[i];
+			set.bits[value >> 5] |= 1u << (value & 31);
+		}
+
+		if (count <= STRING_CHAR_SET_MAX_SIZE)
+			memcpy(set.chars, pChars, count);
+
+		return set;
+	}
+
+	const char* string_scan(const char* pString, const char* pEnd, const StringCharSet& set, bool invert)
+	{
+		iol_assert(pString != nullptr);
+		iol_assert(pEnd != nullptr || invert || string_in_set('\0', set));
+
+		if (set.count > STRING_CHAR_SET_MAX_SIZE)
+			return string_scan_scalar(pString, pEnd, set, invert);
+
+		return string_get_functions().scan(pString, pEnd, set, invert);
+	}
+
+	void string_replace(char* pString, char* pEnd, const StringCharSet& set, char replacement)
+	{
+		iol_assert(pString != nullptr && pEnd >= pString);
+
+		if (set.count > STRING_CHAR_SET_MAX_SIZE)
+		{
+			string_replace_scalar(pString, pEnd, set, replacement);
+			return;
+		}
+
+		string_get_functions().replace(pString, pEnd, set, replacement);
+	}
+}
@@ -24,7 +24,7 @@ namespace iol
 		Camera* m_camera;
 		CameraFlying* m_cameraFlying;
 		TerrainEditor m_terrainEditor;
-		const GraphicsPipelineState* m_pipelineStateDefault;
+		GraphicsPipelineStateHandle m_pipelineStateDefault;
 	};
 }
 
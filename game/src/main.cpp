@@ -14,6 +14,11 @@ int main(int argc, char* argv[])
 	params.fullScreen = false;
 	params.vsync = true;
 	params.fixedUPS = 60;
+	params.frameAllocatorCapacity = 16 * 1024 * 1024;
+	params.numFileIoThreads = 2;
+	params.assetArchivePath = "res.iolpak";
+	params.assetDirectoryPath = "res";
+	params.assetMountPoint = "res";
 	params.quitOnEscape = true;
 
 	{
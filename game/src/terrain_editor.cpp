@@ -43,8 +43,8 @@ namespace iol
 			// MVP Texture
 			GraphicsPipeLineStateParam pipelineParam;
 			pipelineParam.primitiveType = PrimitiveType::TriangleList;
-			pipelineParam.pShader = m_shaderMVPTexture;
-			pipelineParam.pVertexLayout = m_vertexLayoutMVPTexture;
+			pipelineParam.shader = m_shaderMVPTexture;
+			pipelineParam.vertexLayout = m_vertexLayoutMVPTexture;
 			pipelineParam.blendMode = BlendMode::None;
 			m_pipelineStateMVPTexture = g->CreatePipelineState(pipelineParam);
 		}
@@ -53,8 +53,8 @@ namespace iol
 			// MVP Texture Wireframe
 			GraphicsPipeLineStateParam pipelineParam;
 			pipelineParam.primitiveType = PrimitiveType::TriangleList;
-			pipelineParam.pShader = m_shaderMVPTexture;
-			pipelineParam.pVertexLayout = m_vertexLayoutMVPTexture;
+			pipelineParam.shader = m_shaderMVPTexture;
+			pipelineParam.vertexLayout = m_vertexLayoutMVPTexture;
 			pipelineParam.blendMode = BlendMode::None;
 			pipelineParam.rasterizerFlags &= ~RasterizerFlags_BackFaceCulling;
 			pipelineParam.rasterizerFlags |= RasterizerFlags_WireFrame;
@@ -65,8 +65,8 @@ namespace iol
 			// MVP Color Wireframe
 			GraphicsPipeLineStateParam pipelineParam;
 			pipelineParam.primitiveType = PrimitiveType::TriangleList;
-			pipelineParam.pShader = m_shaderMVPColor;
-			pipelineParam.pVertexLayout = m_vertexLayoutMVPColor;
+			pipelineParam.shader = m_shaderMVPColor;
+			pipelineParam.vertexLayout = m_vertexLayoutMVPColor;
 			pipelineParam.blendMode = BlendMode::None;
 			pipelineParam.rasterizerFlags &= ~RasterizerFlags_BackFaceCulling;
 			pipelineParam.rasterizerFlags |= RasterizerFlags_WireFrame;
@@ -108,8 +108,11 @@ namespace iol
 
 		m_indexBuffer = g->CreateIndexBuffer(m_mesh.indices.pData, m_mesh.GetIndexCount(), BufferUsage::DynamicDraw);
 
-		m_vertexArrayMVPTexture = g->CreateVertexArray(m_vertexLayoutMVPTexture, (const VertexBuffer**)&m_vertexBufferPosUV, 1, m_indexBuffer);
-		m_vertexArrayMVPColor = g->CreateVertexArray(m_vertexLayoutMVPColor, (const VertexBuffer**)&m_vertexBufferPos, 1, m_indexBuffer);
+		m_vertexArrayMVPTexture = g->CreateVertexArray(m_vertexLayoutMVPTexture, &m_vertexBufferPosUV, 1, m_indexBuffer);
+		m_vertexArrayMVPColor = g->CreateVertexArray(m_vertexLayoutMVPColor, &m_vertexBufferPos, 1, m_indexBuffer);
+
+		m_selectedTriangles.Create(m_mesh.GetIndexCount() / 3);
+		m_selectedVertices.Create(m_vertexCount);
 
 		//------------------------------------
 		// Load Texture
@@ -143,6 +146,21 @@ namespace iol
 
 		iol_free(m_verticesPosUV);
 		iol_free(m_verticesPos);
+
+		m_selectedTriangles.Destroy();
+		m_selectedVertices.Destroy();
+	}
+
+	void TerrainEditor::SelectVerticesOfSelectedTriangles()
+	{
+		m_selectedVertices.ClearAll();
+
+		for (size_t i = m_selectedTriangles.FindNextSet(0); i != BIT_SET_INVALID_INDEX; i = m_selectedTriangles.FindNextSet(i + 1))
+		{
+			m_selectedVertices.Set(m_mesh.indices[i * 3]);
+			m_selectedVertices.Set(m_mesh.indices[i * 3 + 1]);
+			m_selectedVertices.Set(m_mesh.indices[i * 3 + 2]);
+		}
 	}
 
 	void TerrainEditor::Update(GraphicsSystem* g, const Camera* camera, float deltaTime)
@@ -163,7 +181,8 @@ namespace iol
 		{
 		case TerrainEditState_Initial:
 		{
-			m_selectedIndices.Clear();
+			m_selectedTriangles.ClearAll();
+			m_selectedVertices.ClearAll();
 
 			vec3 rayOrigin;
 			vec3 rayDir;
@@ -171,15 +190,14 @@ namespace iol
 
 			float distance;
 			vec3 hitPoint;
-			Array<uint32> hitTriangleIndices;
+			SmallArray<uint32, 3> hitTriangleIndices;
 
 			if (core::RayIntersectsMesh(rayOrigin, rayDir, m_mesh, distance, hitPoint, hitTriangleIndices))
 			{
-				m_selectedIndices.Create(30000);
-
 				if (m_toolType == TerrainEditToolType_DragHeight)
 				{
-					m_mesh.GetTrianglesInRadius(hitPoint, m_editRadius, m_selectedIndices);
+					m_mesh.GetTrianglesInRadius(hitPoint, m_editRadius, m_selectedTriangles);
+					SelectVerticesOfSelectedTriangles();
 
 					if (leftMouseBtnState == KeyState_Pressed)
 					{
@@ -187,12 +205,12 @@ namespace iol
 						m_startMousePos = mousePos;
 						m_startHitPoint = hitPoint;
 
-						m_selectedOriginalPositions.Create(m_selectedIndices.count);
-						m_selectedOriginalDistances.Create(m_selectedIndices.count);
+						size_t numSelectedVertices = m_selectedVertices.Count();
+						m_selectedOriginalPositions.Create(numSelectedVertices);
+						m_selectedOriginalDistances.Create(numSelectedVertices);
 
-						for (size_t i = 0; i < m_selectedIndices.count; i++)
+						for (size_t vertexIndex = m_selectedVertices.FindNextSet(0); vertexIndex != BIT_SET_INVALID_INDEX; vertexIndex = m_selectedVertices.FindNextSet(vertexIndex + 1))
 						{
-							uint32 vertexIndex = m_selectedIndices[i];
 							vec3 origPos = m_mesh.positions[vertexIndex];
 							float origDistance = glm::length(hitPoint - origPos);
 
@@ -203,17 +221,16 @@ namespace iol
 				}
 				else if (m_toolType == TerrainEditToolType_Flatten)
 				{
-					m_mesh.GetTrianglesInRadiusIgnoreHeight(hitPoint, m_editRadius, m_selectedIndices);
+					m_mesh.GetTrianglesInRadiusIgnoreHeight(hitPoint, m_editRadius, m_selectedTriangles);
+					SelectVerticesOfSelectedTriangles();
 
 					if (leftMouseBtnState == KeyState_Pressed || leftMouseBtnState == KeyState_Holding)
 					{
 						if (m_flattenDesiredHeight == FLT_MAX)
 							m_flattenDesiredHeight = hitPoint.y;
 
-						for (size_t i = 0; i < m_selectedIndices.count; i++)
+						for (size_t vertexIndex = m_selectedVertices.FindNextSet(0); vertexIndex != BIT_SET_INVALID_INDEX; vertexIndex = m_selectedVertices.FindNextSet(vertexIndex + 1))
 						{
-							uint32 vertexIndex = m_selectedIndices[i];
-
 							m_verticesPos[vertexIndex].y = m_flattenDesiredHeight;
 							m_verticesPosUV[vertexIndex].pos.y = m_flattenDesiredHeight;
 							m_mesh.positions[vertexIndex].y = m_flattenDesiredHeight;
@@ -234,10 +251,11 @@ namespace iol
 				vec2 mouseDiff = mousePos - m_startMousePos;
 				float heightDiff = mouseDiff.y * -0.1f;
 
-				for (size_t i = 0; i < m_selectedIndices.count; i++)
-				{
-					uint32 vertexIndex = m_selectedIndices[i];
+				// The original positions were stored in the same order as the set vertices are visited
+				size_t i = 0;
 
+				for (size_t vertexIndex = m_selectedVertices.FindNextSet(0); vertexIndex != BIT_SET_INVALID_INDEX; vertexIndex = m_selectedVertices.FindNextSet(vertexIndex + 1), i++)
+				{
 					float percent = m_selectedOriginalDistances[i] / m_editRadius;
 					percent = core::Clamp(1.0f - percent, 0.0f, 0.9f);
 					float finalHeightDiff = heightDiff * percent;
@@ -295,9 +313,9 @@ namespace iol
 		g->SetIndexBufferData(m_indexBuffer, m_mesh.indices.pData, m_mesh.indices.count);
 
 		g->BindVertexArray(m_vertexArrayMVPTexture);
-		const UniformBuffer* ubsMVPTexture[] = { m_uniformBufferMatrices };
+		const UniformBufferHandle ubsMVPTexture[] = { m_uniformBufferMatrices };
 		g->BindUniformBuffer(ubsMVPTexture, iol_countof(ubsMVPTexture));
-		g->BindTexture(0, (const Texture**)&m_texture, 1);
+		g->BindTexture(0, &m_texture, 1);
 
 		g->DrawIndexed(g->GetIndexBufferNumIndices(m_indexBuffer));
 
@@ -305,22 +323,29 @@ namespace iol
 		// Draw Terrain Selection
 		//------------------------------------
 
-		if (m_selectedIndices.count > 0)
+		size_t numSelectedTriangles = m_selectedTriangles.Count();
+
+		if (numSelectedTriangles > 0)
 		{
+			Array<uint32> selectedIndices(numSelectedTriangles * 3, memory::GetFrameAllocator());
+
+			for (size_t i = m_selectedTriangles.FindNextSet(0); i != BIT_SET_INVALID_INDEX; i = m_selectedTriangles.FindNextSet(i + 1))
+				selectedIndices.PushBackArray(&m_mesh.indices[i * 3], 3);
+
 			g->Clear(vec4(0.0f, 0.0f, 0.0f, 1.0f), ClearFlags_Depth);
 
 			g->SetPipelineState(m_pipelineStateMVPColorWireframe);
-			g->SetIndexBufferData(m_indexBuffer, m_selectedIndices.pData, m_selectedIndices.count);
+			g->SetIndexBufferData(m_indexBuffer, selectedIndices.pData, selectedIndices.count);
 
 			m_uniformDataMaterial.color = glm::vec4(0.f, 1.f, 0.f, 1.f);
 			g->SetUniformBufferData(m_uniformBufferMaterial, &m_uniformDataMaterial, sizeof(m_uniformDataMaterial));
 
 			g->BindVertexArray(m_vertexArrayMVPColor);
-			const UniformBuffer* ubsMVPColor[] = { m_uniformBufferMatrices, m_uniformBufferMaterial };
+			const UniformBufferHandle ubsMVPColor[] = { m_uniformBufferMatrices, m_uniformBufferMaterial };
 			g->BindUniformBuffer(ubsMVPColor, iol_countof(ubsMVPColor));
-			g->BindTexture(0, (const Texture**)&m_texture, 1);
+			g->BindTexture(0, &m_texture, 1);
 
-			g->DrawIndexed(m_selectedIndices.count);
+			g->DrawIndexed(selectedIndices.count);
 		}
 	}
 
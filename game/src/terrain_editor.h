@@ -58,11 +58,12 @@ namespace iol
 		void Render(GraphicsSystem* g, const glm::mat4& viewProjection);
 		void RenderGUI(GraphicsSystem* g);
 
-		const GraphicsPipelineState* GetPipelineStateMVPTexture() const { return m_pipelineStateMVPTexture; }
-		const GraphicsPipelineState* GetPipelineStateMVPTextureWireframe() const { return m_pipelineStateMVPTextureWireframe; }
-		const GraphicsPipelineState* GetPipelineStateMVPColorWireframe() const { return m_pipelineStateMVPColorWireframe; }
+		GraphicsPipelineStateHandle GetPipelineStateMVPTexture() const { return m_pipelineStateMVPTexture; }
+		GraphicsPipelineStateHandle GetPipelineStateMVPTextureWireframe() const { return m_pipelineStateMVPTextureWireframe; }
+		GraphicsPipelineStateHandle GetPipelineStateMVPColorWireframe() const { return m_pipelineStateMVPColorWireframe; }
 
 	private:
+		void SelectVerticesOfSelectedTriangles();
 
 		struct VertexPosUV
 		{
@@ -80,30 +81,30 @@ namespace iol
 			glm::vec4 color;
 		};
 
-		Shader* m_shaderMVPTexture;
-		Shader* m_shaderMVPColor;
-		VertexLayout* m_vertexLayoutMVPTexture;
-		VertexLayout* m_vertexLayoutMVPColor;
-		GraphicsPipelineState* m_pipelineStateMVPTexture;
-		GraphicsPipelineState* m_pipelineStateMVPTextureWireframe;
-		GraphicsPipelineState* m_pipelineStateMVPColorWireframe;
+		ShaderHandle m_shaderMVPTexture;
+		ShaderHandle m_shaderMVPColor;
+		VertexLayoutHandle m_vertexLayoutMVPTexture;
+		VertexLayoutHandle m_vertexLayoutMVPColor;
+		GraphicsPipelineStateHandle m_pipelineStateMVPTexture;
+		GraphicsPipelineStateHandle m_pipelineStateMVPTextureWireframe;
+		GraphicsPipelineStateHandle m_pipelineStateMVPColorWireframe;
 
 		UniformDataMatrices m_uniformDataMatrices;
 		UniformDataMaterial m_uniformDataMaterial;
-		UniformBuffer* m_uniformBufferMatrices;
-		UniformBuffer* m_uniformBufferMaterial;
+		UniformBufferHandle m_uniformBufferMatrices;
+		UniformBufferHandle m_uniformBufferMaterial;
 
 		Mesh m_mesh;
 		VertexPosUV* m_verticesPosUV;
 		glm::vec3* m_verticesPos;
 		size_t m_vertexCount;
-		VertexBuffer* m_vertexBufferPosUV;
-		VertexBuffer* m_vertexBufferPos;
-		IndexBuffer* m_indexBuffer;
-		VertexArray* m_vertexArrayMVPTexture;
-		VertexArray* m_vertexArrayMVPColor;
+		VertexBufferHandle m_vertexBufferPosUV;
+		VertexBufferHandle m_vertexBufferPos;
+		IndexBufferHandle m_indexBuffer;
+		VertexArrayHandle m_vertexArrayMVPTexture;
+		VertexArrayHandle m_vertexArrayMVPColor;
 
-		Texture* m_texture;
+		TextureHandle m_texture;
 
 		TerrainEditToolType m_toolType = TerrainEditToolType_DragHeight;
 		TerrainEditState m_editState = TerrainEditState_Initial;
@@ -117,7 +118,8 @@ namespace iol
 		float m_flattenDesiredHeight = FLT_MAX;
 		glm::vec2 m_startMousePos;
 		glm::vec3 m_startHitPoint;
-		Array<uint32> m_selectedIndices;
+		BitSet m_selectedTriangles;
+		BitSet m_selectedVertices; // vertices of m_selectedTriangles, shared vertices are only edited once
 		Array<glm::vec3> m_selectedOriginalPositions;
 		Array<float> m_selectedOriginalDistances;
 	};
@@ -0,0 +1,21 @@
+#include "iol_vfs.h"
+
+#include <stdio.h>
+
+using namespace iol;
+
+int main(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		printf("usage: iolite_pack <directory> <archive>\n");
+		return 1;
+	}
+
+	if (!vfs::PackDirectory(argv[1], argv[2]))
+		return 1;
+
+	printf("packed '%s' into '%s'\n", argv[1], argv[2]);
+
+	return 0;
+}